@@ -0,0 +1,125 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_BACKEND_HEADLESS_H_
+#define NESCC_BACKEND_HEADLESS_H_
+
+#include "../interface/backend.h"
+
+namespace nescc {
+
+	namespace backend {
+
+		class headless :
+				public nescc::interface::backend {
+
+			public:
+
+				headless(void);
+
+				virtual ~headless(void);
+
+				std::string as_string(
+					__in_opt bool verbose = false
+					) const;
+
+				void create(
+					__in const std::string &title,
+					__in bool crt
+					);
+
+				void destroy(void);
+
+				uint32_t frame(void) const;
+
+				uint64_t hash(void) const;
+
+				const uint32_t *pixel(void) const;
+
+				void present(
+					__in const std::vector<nescc::core::pixel_t> &pixel,
+					__in bool halted,
+					__in bool paused,
+					__in bool changed,
+					__in bool border
+					);
+
+				void set_dump(
+					__in const std::string &path
+					);
+
+				void set_filter(
+					__in bool crt
+					);
+
+				void set_fullscreen(
+					__in bool fullscreen
+					);
+
+				void set_icon(
+					__in const std::string &path
+					);
+
+				void set_low_power(
+					__in bool low_power
+					);
+
+				void set_scale(
+					__in uint32_t scale
+					);
+
+				void set_title(
+					__in const std::string &title
+					);
+
+				void show(
+					__in bool shown
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					) const;
+
+			protected:
+
+				headless(
+					__in const headless &other
+					) = delete;
+
+				headless &operator=(
+					__in const headless &other
+					) = delete;
+
+				void dump(void) const;
+
+				std::string m_dump;
+
+				uint32_t m_frame;
+
+				uint64_t m_hash;
+
+				const nescc::core::pixel_t *m_pixel;
+
+				uint32_t m_scale;
+
+				std::string m_title;
+		};
+	}
+}
+
+#endif // NESCC_BACKEND_HEADLESS_H_
@@ -0,0 +1,135 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_BACKEND_SDL_H_
+#define NESCC_BACKEND_SDL_H_
+
+#include "../interface/backend.h"
+
+namespace nescc {
+
+	namespace backend {
+
+		class sdl :
+				public nescc::interface::backend {
+
+			public:
+
+				sdl(void);
+
+				virtual ~sdl(void);
+
+				std::string as_string(
+					__in_opt bool verbose = false
+					) const;
+
+				void create(
+					__in const std::string &title,
+					__in bool crt
+					);
+
+				void destroy(void);
+
+				void present(
+					__in const std::vector<nescc::core::pixel_t> &pixel,
+					__in bool halted,
+					__in bool paused,
+					__in bool changed,
+					__in bool border
+					);
+
+				void set_filter(
+					__in bool crt
+					);
+
+				void set_fullscreen(
+					__in bool fullscreen
+					);
+
+				void set_icon(
+					__in const std::string &path
+					);
+
+				void set_low_power(
+					__in bool low_power
+					);
+
+				void set_scale(
+					__in uint32_t scale
+					);
+
+				void set_title(
+					__in const std::string &title
+					);
+
+				void show(
+					__in bool shown
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					) const;
+
+			protected:
+
+				sdl(
+					__in const sdl &other
+					) = delete;
+
+				sdl &operator=(
+					__in const sdl &other
+					) = delete;
+
+				void create_texture(void);
+
+				void create_window(
+					__in const std::string &title
+					);
+
+				void destroy_texture(void);
+
+				void destroy_window(void);
+
+				nescc::core::bitmap m_bitmap_border;
+
+				nescc::core::bitmap m_bitmap_halt;
+
+				bool m_crt;
+
+				bool m_low_power;
+
+				bool m_redraw;
+
+				SDL_Renderer *m_renderer;
+
+				uint32_t m_scale;
+
+				SDL_Texture *m_texture;
+
+				SDL_Texture *m_texture_border;
+
+				bool m_texture_dirty;
+
+				SDL_Texture *m_texture_halt;
+
+				SDL_Window *m_window;
+		};
+	}
+}
+
+#endif // NESCC_BACKEND_SDL_H_
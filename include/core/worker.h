@@ -0,0 +1,76 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_CORE_WORKER_H_
+#define NESCC_CORE_WORKER_H_
+
+#include "../interface/band.h"
+#include "./thread.h"
+
+namespace nescc {
+
+	namespace core {
+
+		class worker :
+				public nescc::core::thread {
+
+			public:
+
+				worker(void);
+
+				virtual ~worker(void);
+
+				void dispatch(
+					__in nescc::interface::band &band,
+					__in uint32_t index,
+					__in uint16_t begin,
+					__in uint16_t end
+					);
+
+				void synchronize(void);
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					) const;
+
+			protected:
+
+				worker(
+					__in const worker &other
+					) = delete;
+
+				worker &operator=(
+					__in const worker &other
+					) = delete;
+
+				bool on_run(void);
+
+				nescc::interface::band *m_band;
+
+				uint16_t m_begin;
+
+				uint16_t m_end;
+
+				uint32_t m_index;
+
+				nescc::core::signal m_signal_complete;
+		};
+	}
+}
+
+#endif // NESCC_CORE_WORKER_H_
@@ -19,19 +19,49 @@
 #ifndef NESCC_DISPLAY_H_
 #define NESCC_DISPLAY_H_
 
-#include <vector>
-#include "./core/bitmap.h"
+#include <atomic>
+#include <mutex>
+#include "./backend/headless.h"
+#include "./backend/sdl.h"
 #include "./core/singleton.h"
+#include "./core/thread.h"
+#include "./core/worker.h"
+#include "./interface/band.h"
 
 namespace nescc {
 
+	#define DISPLAY_FRAME_COUNT 3
+
 	#define POST_PROCESS_DEFAULT false
 	#define POST_PROCESS_BLEED_DEFAULT true
 	#define POST_PROCESS_BORDER_DEFAULT true
 	#define POST_PROCESS_SCANLINE_DEFAULT false
 
+	#define POST_PROCESS_SCALE_DEFAULT 1 // unscaled
+	#define POST_PROCESS_SCALE_MAX 4
+
+	enum {
+		POST_PROCESS_SCALER_NEAREST = 0,
+		POST_PROCESS_SCALER_EDGE, // scale2x/scale3x edge-directed scaling
+	};
+
+	#define POST_PROCESS_SCALER_DEFAULT POST_PROCESS_SCALER_EDGE
+	#define POST_PROCESS_SCALER_MAX POST_PROCESS_SCALER_EDGE
+
+#ifndef POST_PROCESS_WORKER_MAX
+	#define POST_PROCESS_WORKER_MAX 3
+#endif // POST_PROCESS_WORKER_MAX
+
+	typedef struct {
+		int type; // window operation
+		bool enabled; // fullscreen or shown state
+		std::string value; // icon path or title
+	} display_window_t;
+
 	class display :
-			public nescc::core::singleton<nescc::display> {
+			public nescc::core::singleton<nescc::display>,
+			protected nescc::core::thread,
+			protected nescc::interface::band {
 
 		public:
 
@@ -41,8 +71,20 @@ namespace nescc {
 				__in_opt bool verbose = false
 				) const;
 
+			nescc::interface::backend &backend(void);
+
+			nescc::backend::headless &backend_headless(void);
+
 			void clear(void);
 
+			bool headless(void) const;
+
+			uint32_t *line(
+				__in uint16_t y
+				);
+
+			bool low_power(void) const;
+
 			uint32_t read(
 				__in uint16_t x,
 				__in uint16_t y
@@ -57,6 +99,10 @@ namespace nescc {
 				__in_opt bool fullscreen = false
 				);
 
+			uint32_t scale(void) const;
+
+			int scaler(void) const;
+
 			void set_filter_crt(
 				__in bool crt,
 				__in_opt bool bleed = POST_PROCESS_BLEED_DEFAULT,
@@ -72,10 +118,23 @@ namespace nescc {
 				__in bool halted
 				);
 
+			void set_headless(
+				__in bool headless
+				);
+
 			void set_icon(
 				__in const std::string &path
 				);
 
+			void set_low_power(
+				__in bool low_power
+				);
+
+			void set_scale(
+				__in uint32_t scale,
+				__in_opt int scaler = POST_PROCESS_SCALER_DEFAULT
+				);
+
 			void set_title(
 				__in const std::string &title
 				);
@@ -93,7 +152,8 @@ namespace nescc {
 			void toggle_fullscreen(void);
 
 			void update(
-				__in_opt bool paused = false
+				__in_opt bool paused = false,
+				__in_opt bool complete = false
 				);
 
 			void write(
@@ -116,57 +176,173 @@ namespace nescc {
 				__in const display &other
 				) = delete;
 
-			void create_texture(void);
+			void create_backend(void);
 
-			void create_window(void);
+			void destroy_backend(void);
 
-			void destroy_texture(void);
+			void filter_crt(
+				__inout std::vector<nescc::core::pixel_t> &frame
+				);
 
-			void destroy_window(void);
+			void filter_crt_band(
+				__in uint32_t index,
+				__in uint16_t begin,
+				__in uint16_t end
+				);
+
+			void generate_blend(
+				__inout std::vector<uint8_t> &table,
+				__in double ratio
+				);
 
-			void filter_crt(void);
+			void on_band(
+				__in uint32_t index,
+				__in uint16_t begin,
+				__in uint16_t end
+				);
 
 			bool on_initialize(void);
 
+			bool on_run(void);
+
 			void on_uninitialize(void);
 
-			nescc::core::bitmap m_bitmap_border;
+			void present(
+				__inout std::vector<nescc::core::pixel_t> &frame,
+				__in bool fresh
+				);
 
-			nescc::core::bitmap m_bitmap_halt;
+			void process_bands(
+				__in int stage,
+				__in uint16_t height
+				);
 
-			bool m_crt;
+			void queue_window(
+				__in int type,
+				__in_opt bool enabled = false,
+				__in_opt const std::string &value = std::string()
+				);
 
-			bool m_crt_bleed;
+			void scale_band(
+				__in uint32_t index,
+				__in uint16_t begin,
+				__in uint16_t end
+				);
 
-			bool m_crt_border;
+			void scale_frame(
+				__in const std::vector<nescc::core::pixel_t> &frame
+				);
+
+			void scale_row_edge_2x(
+				__in const uint32_t *row_up,
+				__in const uint32_t *row,
+				__in const uint32_t *row_down,
+				__inout uint32_t *target
+				);
+
+			void scale_row_edge_3x(
+				__in const uint32_t *row_up,
+				__in const uint32_t *row,
+				__in const uint32_t *row_down,
+				__inout uint32_t *target
+				);
+
+			void scale_row_nearest(
+				__in const uint32_t *row,
+				__inout uint32_t *target
+				);
+
+			void update_window(void);
+
+			nescc::interface::backend *m_backend;
+
+			nescc::backend::headless m_backend_headless;
+
+			nescc::backend::sdl m_backend_sdl;
+
+			std::vector<nescc::core::pixel_t> *m_band_frame;
+
+			int m_band_stage;
+
+			std::atomic<uint32_t> m_crt;
+
+			std::vector<uint32_t> m_crt_artifact;
+
+			std::vector<uint8_t> m_crt_blend_bleed;
+
+			std::vector<uint8_t> m_crt_blend_scanline;
 
 			uint8_t m_crt_frame;
 
-			bool m_crt_scanlines;
+			std::vector<uint32_t> m_crt_line;
+
+			uint32_t m_crt_offset;
+
+			bool m_crt_previous;
 
 			bool m_debug;
 
+			std::vector<nescc::core::pixel_t> m_frame[DISPLAY_FRAME_COUNT];
+
+			uint32_t m_frame_present;
+
+			std::atomic<uint32_t> m_frame_ready;
+
+			uint32_t m_frame_write;
+
 			bool m_fullscreen;
 
-			bool m_halted;
+			std::atomic<bool> m_halted;
+
+			std::atomic<bool> m_low_power;
 
 			std::vector<nescc::core::pixel_t> m_pixel;
 
 			std::vector<nescc::core::pixel_t> m_pixel_previous;
 
-			SDL_Renderer *m_renderer;
+			std::atomic<bool> m_present_close;
+
+			bool m_present_created;
+
+			uint32_t m_present_crt;
+
+			uint64_t m_present_hash;
+
+			bool m_present_low_power;
+
+			uint32_t m_present_scale;
+
+			int m_present_scaler;
+
+			std::atomic<uint32_t> m_scale;
+
+			uint32_t m_scale_factor;
+
+			std::vector<nescc::core::pixel_t> m_scale_frame;
+
+			uint16_t m_scale_height;
+
+			std::vector<nescc::core::pixel_t> m_scale_pass;
+
+			const uint32_t *m_scale_source;
+
+			uint32_t *m_scale_target;
+
+			uint16_t m_scale_width;
 
 			bool m_shown;
 
+			nescc::core::signal m_signal_present;
+
 			std::string m_title;
 
-			SDL_Texture *m_texture;
+			std::vector<display_window_t> m_window;
 
-			SDL_Texture *m_texture_border;
+			std::mutex m_window_mutex;
 
-			SDL_Texture *m_texture_halt;
+			nescc::core::worker m_worker[POST_PROCESS_WORKER_MAX];
 
-			SDL_Window *m_window;
+			uint32_t m_worker_count;
 	};
 }
 
@@ -149,10 +149,12 @@ namespace nescc {
 					);
 
 				void reset(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in_opt bool debug = false
 					);
 
+				uint32_t schedule_limit(void) const;
+
 				std::string to_string(
 					__in_opt bool verbose = false
 					) const;
@@ -162,7 +164,8 @@ namespace nescc {
 				void unpause(void);
 
 				void update(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus,
+					__in uint32_t cycles
 					);
 
 				void write_port(
@@ -184,12 +187,17 @@ namespace nescc {
 					__in const apu &other
 					) = delete;
 
+				static uint32_t event_distance(
+					__in uint32_t cycle,
+					__in float rate
+					);
+
 				bool on_initialize(void);
 
 				void on_uninitialize(void);
 
 				void update_frame(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				void update_frame_envelope(void);
@@ -220,17 +228,26 @@ namespace nescc {
 
 				void update_sample(void);
 
-				void update_timer(void);
+				void update_timer(
+					__in uint32_t cycles
+					);
 
-				void update_timer_dmc(void);
+				void update_timer_dmc(
+					__in uint32_t ticks
+					);
 
-				void update_timer_noise(void);
+				void update_timer_noise(
+					__in uint32_t ticks
+					);
 
 				void update_timer_pulse(
-					__in int channel
+					__in int channel,
+					__in uint32_t ticks
 					);
 
-				void update_timer_triangle(void);
+				void update_timer_triangle(
+					__in uint32_t ticks
+					);
 
 				nescc::core::audio_buffer m_buffer;
 
@@ -244,6 +261,10 @@ namespace nescc {
 
 				nescc::emulator::port_dmc_timer_t m_dmc_timer;
 
+				uint32_t m_event_frame;
+
+				uint32_t m_event_sample;
+
 				SDL_AudioSpec m_format;
 
 				nescc::emulator::port_frame_t m_frame;
@@ -31,7 +31,13 @@ namespace nescc {
 
 	namespace emulator {
 
-		class bus :
+		#define BUS_PAGE_COUNT ((UINT16_MAX + 1) >> BUS_PAGE_SHIFT)
+		#define BUS_PAGE_LENGTH (1 << BUS_PAGE_SHIFT)
+		#define BUS_PAGE_MASK (BUS_PAGE_LENGTH - 1)
+		#define BUS_PAGE_SHIFT 10
+		#define BUS_PAGE_TILE_COUNT 8 // 0x0000 - 0x1fff
+
+		class bus final :
 				public nescc::core::singleton<nescc::emulator::bus>,
 				public nescc::emulator::interface::bus {
 
@@ -74,6 +80,10 @@ namespace nescc {
 					__in bool halt
 					);
 
+				uint32_t *display_line(
+					__in uint16_t y
+					);
+
 				void display_update(void);
 
 				void display_write(
@@ -107,6 +117,10 @@ namespace nescc {
 					__in uint16_t address
 					);
 
+				const uint8_t *ppu_read_tile(
+					__in uint16_t address
+					);
+
 				void ppu_set_mirroring(
 					__in uint8_t value
 					);
@@ -129,10 +143,18 @@ namespace nescc {
 					__in uint8_t value
 					);
 
+				void ppu_write_oam_page(
+					__in uint16_t address
+					);
+
 				void reset(
 					__in_opt bool debug = false
 					);
 
+				void set_frame_skip(
+					__in uint32_t skip
+					);
+
 				void step(
 					__inout int32_t &cycle
 					);
@@ -159,10 +181,14 @@ namespace nescc {
 					__in const bus &other
 					) = delete;
 
+				void map_pages(void);
+
 				bool on_initialize(void);
 
 				void on_uninitialize(void);
 
+				void unmap_pages(void);
+
 				nescc::emulator::apu &m_apu;
 
 				nescc::emulator::cpu &m_cpu;
@@ -175,6 +201,12 @@ namespace nescc {
 
 				nescc::emulator::mmu &m_mmu;
 
+				uint8_t *m_page_read[BUS_PAGE_COUNT];
+
+				uint8_t *m_page_tile[BUS_PAGE_TILE_COUNT];
+
+				uint8_t *m_page_write[BUS_PAGE_COUNT];
+
 				nescc::emulator::ppu &m_ppu;
 
 				std::set<uint16_t> m_watch_cpu;
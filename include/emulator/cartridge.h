@@ -109,12 +109,15 @@ namespace nescc {
 		enum {
 			CARTRIDGE_MIRRORING_HORIZONTAL = 0,
 			CARTRIDGE_MIRRORING_VERTICAL,
+			CARTRIDGE_MIRRORING_SINGLE_LOWER,
+			CARTRIDGE_MIRRORING_SINGLE_UPPER,
+			CARTRIDGE_MIRRORING_FOUR_SCREEN,
 		};
 
-		#define CARTRIDGE_MIRRORING_MAX nescc::emulator::CARTRIDGE_MIRRORING_VERTICAL
+		#define CARTRIDGE_MIRRORING_MAX nescc::emulator::CARTRIDGE_MIRRORING_FOUR_SCREEN
 
 		static const std::string CARTRIDGE_MIRRORING_STR[] = {
-			"Horizontal", "Vertical",
+			"Horizontal", "Vertical", "Single-screen (lower)", "Single-screen (upper)", "Four-screen",
 			};
 
 		#define CARTRIDGE_MIRRORING_STRING(_TYPE_) \
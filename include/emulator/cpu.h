@@ -32,6 +32,36 @@ namespace nescc {
 
 		#define CPU_OAM_DMA 0x4014
 
+		#define CPU_INSTRUCTION_LENGTH_MAX 3
+
+		typedef struct {
+			uint32_t generation; // cache generation the entry was decoded in
+			uint8_t data[CPU_INSTRUCTION_LENGTH_MAX]; // opcode and operand bytes
+			uint8_t length; // instruction length
+		} cpu_instruction_t;
+
+		enum {
+			CPU_IDLE_NONE = 0,
+			CPU_IDLE_JUMP, // absolute jump to itself
+			CPU_IDLE_POLL_RAM, // ram load, followed by a branch back to it
+			CPU_IDLE_POLL_STATUS, // ppu status load, followed by a bpl back to it
+		};
+
+		#define CPU_IDLE_LENGTH_MAX 2
+
+		typedef struct {
+			uint16_t address[CPU_IDLE_LENGTH_MAX]; // loop instruction addresses
+			uint8_t cycles[CPU_IDLE_LENGTH_MAX]; // loop instruction cycles
+			uint8_t index; // next loop instruction
+			uint8_t length; // loop instruction count (0 if no loop is armed)
+			cpu_instruction_t *previous; // previously executed instruction
+			uint16_t previous_address; // previously executed instruction address
+			uint8_t previous_cycles; // previously executed instruction cycles
+			uint8_t type; // loop type
+			uint16_t watch; // polled ram address
+			uint8_t watch_value; // polled ram value
+		} cpu_idle_t;
+
 		class cpu :
 				public nescc::core::singleton<nescc::emulator::cpu> {
 
@@ -53,7 +83,7 @@ namespace nescc {
 				void clear(void);
 
 				std::string command_as_string(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint16_t address,
 					__in_opt uint16_t offset = 1,
 					__in_opt bool verbose = false
@@ -65,6 +95,8 @@ namespace nescc {
 
 				bool halted(void) const;
 
+				uint8_t idle(void) const;
+
 				uint8_t index_x(void) const;
 
 				uint8_t index_y(void) const;
@@ -73,6 +105,8 @@ namespace nescc {
 
 				void interrupt_non_maskable(void);
 
+				void invalidate_instructions(void);
+
 				nescc::core::memory<uint8_t> &oam_dma(void);
 
 				uint16_t program_counter(void) const;
@@ -80,7 +114,7 @@ namespace nescc {
 				nescc::core::memory<uint8_t> &ram(void);
 
 				void reset(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in bool powerup,
 					__in_opt bool debug = false
 					);
@@ -94,7 +128,7 @@ namespace nescc {
 					);
 
 				void set_halt(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in bool halt
 					);
 
@@ -120,12 +154,16 @@ namespace nescc {
 					__in_opt bool verbose = false
 					) const;
 
-				uint8_t update(
-					__in nescc::emulator::interface::bus &bus
+				uint16_t update(
+					__in BUS_TYPE &bus
+					);
+
+				uint16_t update_idle(
+					__in uint32_t limit
 					);
 
 				void write_oam_dma(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint8_t bank
 					);
 
@@ -148,81 +186,99 @@ namespace nescc {
 					);
 
 				uint16_t address_absolute(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint16_t address_absolute_x(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__inout bool &boundary
 					);
 
 				uint16_t address_absolute_y(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__inout bool &boundary
 					);
 
 				uint16_t address_indirect(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint16_t address_indirect_x(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint16_t address_indirect_y(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
+					__inout bool &boundary
+					);
+
+				template<uint8_t MODE> uint16_t address_operand(
+					__in BUS_TYPE &bus,
 					__inout bool &boundary
 					);
 
 				uint16_t address_relative(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__inout bool &boundary
 					);
 
 				uint16_t address_zero_page(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint16_t address_zero_page_x(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint16_t address_zero_page_y(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
+					);
+
+				template<uint8_t OPCODE> uint8_t execute(
+					__in BUS_TYPE &bus
+					);
+
+				uint8_t execute_command(
+					__in BUS_TYPE &bus,
+					__in const std::pair<uint8_t, uint8_t> &command
+					);
+
+				template<uint8_t COMMAND, uint8_t MODE> uint8_t execute_command(
+					__in BUS_TYPE &bus
 					);
 
 				uint8_t execute_command_add(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_and(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_bit(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_branch(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_break(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_compare(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_decrement(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
@@ -231,147 +287,147 @@ namespace nescc {
 					);
 
 				uint8_t execute_command_illegal(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_decrement(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_halt(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_increment(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_load(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_nop(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_rotate_left(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_rotate_right(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_shift_left(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_shift_right(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_store(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_illegal_subtract(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_increment(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_jump(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_load(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_nop(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_or(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_or_exclusive(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_rotate_left(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_rotate_right(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_return(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_return_interrupt(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_shift_left(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_shift_right(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_stack_pull(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_stack_push(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_store(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_subroutine(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
 				uint8_t execute_command_subtract(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
@@ -379,12 +435,30 @@ namespace nescc {
 					__in const std::pair<uint8_t, uint8_t> &command
 					);
 
+				uint8_t fetch_byte(
+					__in BUS_TYPE &bus
+					);
+
+				cpu_instruction_t *fetch_instruction(
+					__in BUS_TYPE &bus
+					);
+
+				uint16_t fetch_word(
+					__in BUS_TYPE &bus
+					);
+
+				uint8_t flags_evaluate(void) const;
+
+				void idle_detect(
+					__in uint8_t cycles
+					);
+
 				uint8_t interrupt_maskable(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint8_t interrupt_non_maskable(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				bool on_initialize(void);
@@ -392,30 +466,35 @@ namespace nescc {
 				void on_uninitialize(void);
 
 				uint8_t pull_byte(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint16_t pull_word(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				void push_byte(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint8_t value
 					);
 
 				void push_word(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint16_t value
 					);
 
 				uint8_t read_byte(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint16_t address
 					);
 
+				template<uint8_t MODE> uint8_t read_operand(
+					__in BUS_TYPE &bus,
+					__inout bool &boundary
+					);
+
 				uint16_t read_word(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint16_t address
 					);
 
@@ -436,17 +515,21 @@ namespace nescc {
 					);
 
 				uint8_t step(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
+					);
+
+				uint8_t step_idle(
+					__in BUS_TYPE &bus
 					);
 
 				void write_byte(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint16_t address,
 					__in uint8_t value
 					);
 
 				void write_word(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint16_t address,
 					__in uint16_t value
 					);
@@ -459,14 +542,30 @@ namespace nescc {
 
 				uint8_t m_flags;
 
+				bool m_flags_lazy;
+
+				uint8_t m_flags_result;
+
 				bool m_halt;
 
+				cpu_idle_t m_idle;
+
 				uint8_t m_index_x;
 
 				uint8_t m_index_y;
 
+				cpu_instruction_t *m_instruction;
+
+				uint16_t m_instruction_address;
+
+				std::vector<cpu_instruction_t> m_instruction_cache;
+
+				uint32_t m_instruction_generation;
+
 				nescc::core::memory<uint8_t> m_oam_dma;
 
+				bool m_oam_dma_stall;
+
 				uint16_t m_program_counter;
 
 				nescc::core::memory<uint8_t> m_ram;
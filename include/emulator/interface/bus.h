@@ -23,6 +23,20 @@ namespace nescc {
 
 	namespace emulator {
 
+#ifndef BUS_BIND
+		#define BUS_BIND 1
+#endif // BUS_BIND
+
+#if BUS_BIND
+		class bus;
+
+		// components take the concrete bus, so their bus calls bind at compile-time (build with BUS_BIND=0 to
+		// drive the components through another interface::bus implementation)
+		#define BUS_TYPE nescc::emulator::bus
+#else
+		#define BUS_TYPE nescc::emulator::interface::bus
+#endif // BUS_BIND
+
 		namespace interface {
 
 			class bus {
@@ -52,6 +66,14 @@ namespace nescc {
 						__in bool halt
 						) = 0;
 
+					// without a framebuffer row to hand out, the ppu writes its row through display_write
+					virtual uint32_t *display_line(
+						__in uint16_t y
+						)
+					{
+						return nullptr;
+					}
+
 					virtual void display_update(void) = 0;
 
 					virtual void display_write(
@@ -74,6 +96,14 @@ namespace nescc {
 						__in uint16_t address
 						) = 0;
 
+					// without decoded tiles, the ppu reads its tile rows through ppu_read
+					virtual const uint8_t *ppu_read_tile(
+						__in uint16_t address
+						)
+					{
+						return nullptr;
+					}
+
 					virtual void ppu_set_mirroring(
 						__in uint8_t value
 						) = 0;
@@ -87,6 +117,17 @@ namespace nescc {
 						__in uint16_t address,
 						__in uint8_t value
 						) = 0;
+
+					// without direct page access, the page is copied a byte at a time
+					virtual void ppu_write_oam_page(
+						__in uint16_t address
+						)
+					{
+
+						for(uint16_t iter = 0; iter <= UINT8_MAX; ++iter) {
+							ppu_write_oam(iter, cpu_read(address + iter));
+						}
+					}
 			};
 		};
 	}
@@ -93,7 +93,8 @@ namespace nescc {
 						__in uint8_t value
 						) = 0;
 
-					virtual void write_rom_program(
+					// returns true when the write changed what the cartridge maps into cpu or ppu address space
+					virtual bool write_rom_program(
 						__in nescc::emulator::interface::bus &bus,
 						__in nescc::emulator::cartridge &cartridge,
 						__in uint16_t address,
@@ -117,7 +117,7 @@ namespace nescc {
 						__in uint8_t value
 						);
 
-					void write_rom_program(
+					bool write_rom_program(
 						__in nescc::emulator::interface::bus &bus,
 						__in nescc::emulator::cartridge &cartridge,
 						__in uint16_t address,
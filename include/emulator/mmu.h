@@ -30,6 +30,16 @@ namespace nescc {
 
 	namespace emulator {
 
+		#define MMU_TILE_LENGTH 16 // character bytes per tile
+		#define MMU_TILE_PLANE 8 // offset of the high bit plane
+		#define MMU_TILE_SCALE 4 // decoded bytes per character byte
+		#define MMU_TILE_WIDTH 8
+
+		// decoded tiles hold each row as 8 chunky pixel indices, so a row's offset is four times the offset of
+		// its low bit plane
+		#define MMU_TILE_OFFSET(_ADDRESS_) \
+			((((_ADDRESS_) & ~(MMU_TILE_LENGTH - 1)) * MMU_TILE_SCALE) + (((_ADDRESS_) & (MMU_TILE_PLANE - 1)) * MMU_TILE_WIDTH))
+
 		class mmu :
 				public nescc::core::singleton<nescc::emulator::mmu> {
 
@@ -47,6 +57,21 @@ namespace nescc {
 
 				uint8_t mirroring(void) const;
 
+				uint8_t *page_ram(
+					__in uint16_t address,
+					__in uint16_t length
+					);
+
+				uint8_t *page_rom_program(
+					__in uint16_t address,
+					__in uint16_t length
+					);
+
+				uint8_t *page_tile(
+					__in uint16_t address,
+					__in uint16_t length
+					);
+
 				nescc::core::memory<uint8_t> &ram(
 					__inout uint16_t &address
 					);
@@ -93,7 +118,7 @@ namespace nescc {
 					__in uint8_t value
 					);
 
-				void write_rom_program(
+				bool write_rom_program(
 					__in nescc::emulator::interface::bus &bus,
 					__in uint16_t address,
 					__in uint8_t value
@@ -113,6 +138,17 @@ namespace nescc {
 					__in const mmu &other
 					) = delete;
 
+				uint8_t bank_rom_character(
+					__inout uint16_t &address
+					);
+
+				void decode_tile(
+					__in uint8_t bank,
+					__in uint16_t address
+					);
+
+				nescc::emulator::interface::mapper &mapper(void);
+
 				bool on_initialize(void);
 
 				void on_uninitialize(void);
@@ -132,6 +168,8 @@ namespace nescc {
 				nescc::emulator::mapper::txrom m_mapper_txrom;
 
 				nescc::emulator::mapper::uxrom m_mapper_uxrom;
+
+				std::vector<nescc::core::memory<uint8_t>> m_tile;
 		};
 	}
 }
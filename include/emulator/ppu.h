@@ -40,9 +40,14 @@ namespace nescc {
 
 		#define PPU_PORT_MAX PPU_PORT_DATA
 
+		#define PPU_NAMETABLE_COUNT 4
 		#define PPU_NAMETABLE_LENGTH 0x400
 		#define PPU_OAM_LENGTH 0x100
+		#define PPU_PALETTE_COLOR_LENGTH 0x40
+		#define PPU_PALETTE_COLOR_TABLE_LENGTH 0x10 // greyscale x emphasis combinations
 		#define PPU_PALETTE_LENGTH 0x20
+		#define PPU_SPRITE_LINE_LENGTH 0x100
+		#define PPU_SPRITE_ROW_LENGTH 8
 
 		union port_address_t {
 			struct {
@@ -102,8 +107,7 @@ namespace nescc {
 			uint8_t position_y; // sprite y (top) position
 			uint8_t tile; // sprite tile index
 			uint8_t attributes; // sprite attributes
-			uint8_t data_low; // sprite tile data (low)
-			uint8_t data_high; // sprite tile data (high)
+			uint8_t data[PPU_SPRITE_ROW_LENGTH]; // sprite tile row (pixel indices)
 		} sprite_t;
 
 		class ppu :
@@ -152,17 +156,25 @@ namespace nescc {
 					);
 
 				uint8_t read_port(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint8_t port
 					);
 
 				void reset(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in_opt bool debug = false
 					);
 
 				uint32_t scanline(void) const;
 
+				bool schedule(
+					__in uint32_t cycles
+					);
+
+				uint32_t schedule_limit(
+					__in_opt bool status = false
+					) const;
+
 				uint8_t scroll(void) const;
 
 				void set_address(
@@ -177,6 +189,10 @@ namespace nescc {
 					__in uint8_t value
 					);
 
+				void set_frame_skip(
+					__in uint32_t skip
+					);
+
 				void set_mask(
 					__in uint8_t value
 					);
@@ -203,12 +219,16 @@ namespace nescc {
 
 				nescc::emulator::port_status_t status(void) const;
 
+				void synchronize(
+					__in BUS_TYPE &bus
+					);
+
 				std::string to_string(
 					__in_opt bool verbose = false
 					) const;
 
 				void update(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				void write_nametable(
@@ -221,13 +241,17 @@ namespace nescc {
 					__in uint8_t value
 					);
 
+				void write_oam_page(
+					__in const uint8_t *data
+					);
+
 				void write_palette(
 					__in uint16_t address,
 					__in uint8_t value
 					);
 
 				void write_port(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint8_t port,
 					__in uint8_t value
 					);
@@ -254,27 +278,37 @@ namespace nescc {
 
 				void clear_oam_secondary(void);
 
+				uint32_t event_distance(
+					__in_opt bool status = false
+					) const;
+
 				void execute_post_render(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				void execute_render(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in int type
 					);
 
 				void execute_render_background(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in int type
 					);
 
+				void execute_render_scanline(
+					__in BUS_TYPE &bus
+					);
+
 				void execute_render_sprite(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in int type
 					);
 
+				void generate_palette(void);
+
 				void generate_pixel(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				void generate_pixel_background(
@@ -282,6 +316,11 @@ namespace nescc {
 					__inout uint8_t &palette
 					);
 
+				void generate_pixel_line(
+					__in BUS_TYPE &bus,
+					__in const uint8_t *background
+					);
+
 				void generate_pixel_sprite(
 					__in int dot,
 					__in uint8_t palette,
@@ -294,7 +333,7 @@ namespace nescc {
 				void on_uninitialize(void);
 
 				uint8_t read_port_data(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
 				uint8_t read_port_oam_data(void);
@@ -306,9 +345,13 @@ namespace nescc {
 				void sprite_evaluate(void);
 
 				void sprite_load(
-					__in nescc::emulator::interface::bus &bus
+					__in BUS_TYPE &bus
 					);
 
+				void update_nametable(void);
+
+				void update_palette(void);
+
 				void update_position_horizontal(void);
 
 				void update_position_vertical(void);
@@ -328,7 +371,7 @@ namespace nescc {
 					);
 
 				void write_port_data(
-					__in nescc::emulator::interface::bus &bus,
+					__in BUS_TYPE &bus,
 					__in uint8_t value
 					);
 
@@ -376,6 +419,10 @@ namespace nescc {
 
 				uint32_t m_cycle;
 
+				uint32_t m_cycle_event;
+
+				uint32_t m_cycle_target;
+
 				bool m_debug;
 
 				uint32_t m_dot;
@@ -384,6 +431,12 @@ namespace nescc {
 
 				bool m_frame_odd;
 
+				uint32_t m_frame_skip;
+
+				uint32_t m_frame_skip_count;
+
+				bool m_frame_skipped;
+
 				nescc::emulator::port_mask_t m_mask;
 
 				uint8_t m_mirroring;
@@ -392,10 +445,16 @@ namespace nescc {
 
 				uint8_t m_nametable_current;
 
+				uint8_t *m_nametable_slot[PPU_NAMETABLE_COUNT];
+
 				nescc::core::memory<uint8_t> m_oam;
 
 				nescc::core::memory<uint8_t> m_palette;
 
+				uint32_t m_palette_cache[PPU_PALETTE_LENGTH];
+
+				uint32_t m_palette_color[PPU_PALETTE_COLOR_TABLE_LENGTH][PPU_PALETTE_COLOR_LENGTH];
+
 				nescc::core::memory<uint8_t> m_port;
 
 				bool m_port_latch;
@@ -408,6 +467,8 @@ namespace nescc {
 
 				std::vector<nescc::emulator::sprite_t> m_sprite;
 
+				uint8_t m_sprite_line[PPU_SPRITE_LINE_LENGTH];
+
 				std::vector<nescc::emulator::sprite_t> m_sprite_secondary;
 
 				nescc::emulator::port_status_t m_status;
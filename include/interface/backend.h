@@ -0,0 +1,90 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_INTERFACE_BACKEND_H_
+#define NESCC_INTERFACE_BACKEND_H_
+
+#include <vector>
+#include "../core/bitmap.h"
+
+namespace nescc {
+
+	#define DISPLAY_HEIGHT 240
+	#define DISPLAY_WIDTH 256
+
+	namespace interface {
+
+		class backend {
+
+			public:
+
+				virtual std::string as_string(
+					__in_opt bool verbose = false
+					) const = 0;
+
+				virtual void create(
+					__in const std::string &title,
+					__in bool crt
+					) = 0;
+
+				virtual void destroy(void) = 0;
+
+				virtual void present(
+					__in const std::vector<nescc::core::pixel_t> &pixel,
+					__in bool halted,
+					__in bool paused,
+					__in bool changed,
+					__in bool border
+					) = 0;
+
+				virtual void set_filter(
+					__in bool crt
+					) = 0;
+
+				virtual void set_fullscreen(
+					__in bool fullscreen
+					) = 0;
+
+				virtual void set_icon(
+					__in const std::string &path
+					) = 0;
+
+				virtual void set_low_power(
+					__in bool low_power
+					) = 0;
+
+				virtual void set_scale(
+					__in uint32_t scale
+					) = 0;
+
+				virtual void set_title(
+					__in const std::string &title
+					) = 0;
+
+				virtual void show(
+					__in bool shown
+					) = 0;
+
+				virtual std::string to_string(
+					__in_opt bool verbose = false
+					) const = 0;
+		};
+	}
+}
+
+#endif // NESCC_INTERFACE_BACKEND_H_
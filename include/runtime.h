@@ -19,6 +19,7 @@
 #ifndef NESCC_RUNTIME_H_
 #define NESCC_RUNTIME_H_
 
+#include <atomic>
 #include "./emulator/bus.h"
 #include "./trace.h"
 
@@ -47,11 +48,19 @@ namespace nescc {
 				__in_opt bool debug = false,
 				__in_opt bool step = false,
 				__in_opt bool step_frame = false,
-				__in_opt bool crt_filter = false
+				__in_opt bool crt_filter = false,
+				__in_opt bool headless = false,
+				__in_opt bool low_power = false,
+				__in_opt uint32_t frame_skip = 0,
+				__in_opt uint32_t scale = POST_PROCESS_SCALE_DEFAULT
 				);
 
 			bool running(void) const;
 
+			void set_frame_skip(
+				__in uint32_t skip
+				);
+
 			void step(void);
 
 			bool stepping(void) const;
@@ -102,6 +111,8 @@ namespace nescc {
 
 			void on_uninitialize(void);
 
+			void update_frame_skip(void);
+
 			nescc::emulator::bus &m_bus;
 
 			bool m_crt_filter;
@@ -112,8 +123,18 @@ namespace nescc {
 
 			uint32_t m_frame;
 
+			std::atomic<uint32_t> m_frame_skip;
+
+			std::atomic<bool> m_frame_skip_pending;
+
+			bool m_headless;
+
+			bool m_low_power;
+
 			std::string m_path;
 
+			uint32_t m_scale;
+
 			bool m_step;
 
 			bool m_step_frame;
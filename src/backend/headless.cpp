@@ -0,0 +1,292 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include "../../include/backend/headless.h"
+#include "../../include/core/hash.h"
+#include "../../include/trace.h"
+#include "./headless_type.h"
+
+namespace nescc {
+
+	namespace backend {
+
+		headless::headless(void) :
+			m_frame(0),
+			m_hash(HASH_BASIS),
+			m_pixel(nullptr),
+			m_scale(HEADLESS_SCALE_DEFAULT)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		headless::~headless(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		std::string
+		headless::as_string(
+			__in_opt bool verbose
+			) const
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
+
+			result << std::left << std::setw(COLUMN_WIDTH) << "Backend" << "Headless"
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Dimensions" << DISPLAY_WIDTH << ", " << DISPLAY_HEIGHT
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Scale" << m_scale
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Frame" << m_frame
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Hash" << SCALAR_AS_HEX(uint64_t, m_hash)
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Dump" << (m_dump.empty() ? "Disabled" : m_dump);
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void
+		headless::create(
+			__in const std::string &title,
+			__in bool crt
+			)
+		{
+			TRACE_ENTRY_FORMAT("Title[%u]=%s, CRT filter=%x", title.size(), STRING_CHECK(title), crt);
+
+			m_frame = 0;
+			m_hash = HASH_BASIS;
+			m_pixel = nullptr;
+			m_scale = HEADLESS_SCALE_DEFAULT;
+			m_title = title;
+
+			TRACE_EXIT();
+		}
+
+		void
+		headless::destroy(void)
+		{
+			TRACE_ENTRY();
+
+			m_pixel = nullptr;
+			m_title.clear();
+
+			TRACE_EXIT();
+		}
+
+		void
+		headless::dump(void) const
+		{
+			uint32_t index;
+			std::ofstream file;
+			std::stringstream path;
+
+			TRACE_ENTRY();
+
+			path << m_dump << std::setw(HEADLESS_DUMP_INDEX_WIDTH) << std::setfill('0') << m_frame
+				<< HEADLESS_DUMP_EXTENSION;
+
+			file = std::ofstream(path.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if(!file) {
+				THROW_NESCC_BACKEND_HEADLESS_EXCEPTION_FORMAT(NESCC_BACKEND_HEADLESS_EXCEPTION_FILE_NOT_CREATED,
+					"Path[%u]=%s", path.str().size(), STRING_CHECK(path.str()));
+			}
+
+			file << HEADLESS_DUMP_FORMAT << std::endl << (DISPLAY_WIDTH * m_scale) << " " << (DISPLAY_HEIGHT * m_scale)
+				<< std::endl << HEADLESS_DUMP_MAX << std::endl;
+
+			for(index = 0; index < (DISPLAY_WIDTH * DISPLAY_HEIGHT * m_scale * m_scale); ++index) {
+				const nescc::core::pixel_t &value = m_pixel[index];
+
+				file.put(value.red);
+				file.put(value.green);
+				file.put(value.blue);
+			}
+
+			file.close();
+
+			TRACE_EXIT();
+		}
+
+		uint32_t
+		headless::frame(void) const
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT_FORMAT("Result=%u", m_frame);
+			return m_frame;
+		}
+
+		uint64_t
+		headless::hash(void) const
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT_FORMAT("Result=%016llx", m_hash);
+			return m_hash;
+		}
+
+		const uint32_t *
+		headless::pixel(void) const
+		{
+			const uint32_t *result = nullptr;
+
+			TRACE_ENTRY();
+
+			if(m_pixel) {
+				result = &m_pixel->raw;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
+		void
+		headless::present(
+			__in const std::vector<nescc::core::pixel_t> &pixel,
+			__in bool halted,
+			__in bool paused,
+			__in bool changed,
+			__in bool border
+			)
+		{
+			TRACE_ENTRY_FORMAT("Pixel[%u]=%p, Halted=%x, Paused=%x, Changed=%x, Border=%x", pixel.size(), &pixel[0], halted,
+				paused, changed, border);
+
+			if(!halted && !paused) {
+				m_hash = nescc::core::hash::frame(pixel);
+				m_pixel = &pixel[0];
+				++m_frame;
+
+				if(!m_dump.empty()) {
+					dump();
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_dump(
+			__in const std::string &path
+			)
+		{
+			TRACE_ENTRY_FORMAT("Path[%u]=%s", path.size(), STRING_CHECK(path));
+
+			m_dump = path;
+
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_filter(
+			__in bool crt
+			)
+		{
+			TRACE_ENTRY_FORMAT("CRT filter=%x", crt);
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_fullscreen(
+			__in bool fullscreen
+			)
+		{
+			TRACE_ENTRY_FORMAT("Fullscreen=%x", fullscreen);
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_icon(
+			__in const std::string &path
+			)
+		{
+			TRACE_ENTRY_FORMAT("Path[%u]=%s", path.size(), STRING_CHECK(path));
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_low_power(
+			__in bool low_power
+			)
+		{
+			TRACE_ENTRY_FORMAT("Low-power=%x", low_power);
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_scale(
+			__in uint32_t scale
+			)
+		{
+			TRACE_ENTRY_FORMAT("Scale=%u", scale);
+
+			// presented frames arrive scaled, so only their size is kept
+			m_scale = scale;
+
+			TRACE_EXIT();
+		}
+
+		void
+		headless::set_title(
+			__in const std::string &title
+			)
+		{
+			TRACE_ENTRY_FORMAT("Title[%u]=%s", title.size(), STRING_CHECK(title));
+
+			m_title = title;
+
+			TRACE_EXIT();
+		}
+
+		void
+		headless::show(
+			__in bool shown
+			)
+		{
+			TRACE_ENTRY_FORMAT("Shown=%x", shown);
+			TRACE_EXIT();
+		}
+
+		std::string
+		headless::to_string(
+			__in_opt bool verbose
+			) const
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
+
+			result << NESCC_BACKEND_HEADLESS_HEADER << "(" << SCALAR_AS_HEX(uintptr_t, this) << ")";
+
+			if(verbose) {
+				result << " Frame=" << m_frame
+					<< ", Hash=" << SCALAR_AS_HEX(uint64_t, m_hash)
+					<< ", Pixel=" << SCALAR_AS_HEX(uintptr_t, m_pixel)
+					<< ", Scale=" << m_scale
+					<< ", Title[" << m_title.size() << "]=" << STRING_CHECK(m_title);
+
+				if(!m_dump.empty()) {
+					result << ", Dump[" << m_dump.size() << "]=" << m_dump;
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+	}
+}
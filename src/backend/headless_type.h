@@ -0,0 +1,63 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_BACKEND_HEADLESS_TYPE_H_
+#define NESCC_BACKEND_HEADLESS_TYPE_H_
+
+#include "../../include/exception.h"
+
+namespace nescc {
+
+	namespace backend {
+
+		#define NESCC_BACKEND_HEADLESS_HEADER "[NESCC::BACKEND::HEADLESS]"
+#ifndef NDEBUG
+		#define NESCC_BACKEND_HEADLESS_EXCEPTION_HEADER NESCC_BACKEND_HEADLESS_HEADER " "
+#else
+		#define NESCC_BACKEND_HEADLESS_EXCEPTION_HEADER
+#endif // NDEBUG
+
+		enum {
+			NESCC_BACKEND_HEADLESS_EXCEPTION_FILE_NOT_CREATED = 0,
+		};
+
+		#define NESCC_BACKEND_HEADLESS_EXCEPTION_MAX NESCC_BACKEND_HEADLESS_EXCEPTION_FILE_NOT_CREATED
+
+		static const std::string NESCC_BACKEND_HEADLESS_EXCEPTION_STR[] = {
+			NESCC_BACKEND_HEADLESS_EXCEPTION_HEADER "Failed to create dump file",
+			};
+
+		#define NESCC_BACKEND_HEADLESS_EXCEPTION_STRING(_TYPE_) \
+			(((_TYPE_) > NESCC_BACKEND_HEADLESS_EXCEPTION_MAX) ? EXCEPTION_UNKNOWN : \
+				STRING_CHECK(NESCC_BACKEND_HEADLESS_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_NESCC_BACKEND_HEADLESS_EXCEPTION(_EXCEPT_) \
+			THROW_NESCC_BACKEND_HEADLESS_EXCEPTION_FORMAT(_EXCEPT_, "", "")
+		#define THROW_NESCC_BACKEND_HEADLESS_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_FORMAT(NESCC_BACKEND_HEADLESS_EXCEPTION_STRING(_EXCEPT_), \
+				_FORMAT_, __VA_ARGS__)
+
+		#define HEADLESS_DUMP_EXTENSION ".ppm"
+		#define HEADLESS_DUMP_FORMAT "P6"
+		#define HEADLESS_DUMP_INDEX_WIDTH 6
+		#define HEADLESS_DUMP_MAX UINT8_MAX
+		#define HEADLESS_SCALE_DEFAULT 1 // unscaled
+	}
+}
+
+#endif // NESCC_BACKEND_HEADLESS_TYPE_H_
@@ -0,0 +1,484 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "../../include/backend/sdl.h"
+#include "../../include/trace.h"
+#include "./sdl_type.h"
+
+namespace nescc {
+
+	namespace backend {
+
+		sdl::sdl(void) :
+			m_crt(false),
+			m_low_power(false),
+			m_redraw(true),
+			m_renderer(nullptr),
+			m_scale(1),
+			m_texture(nullptr),
+			m_texture_border(nullptr),
+			m_texture_dirty(true),
+			m_texture_halt(nullptr),
+			m_window(nullptr)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		sdl::~sdl(void)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		std::string
+		sdl::as_string(
+			__in_opt bool verbose
+			) const
+		{
+			std::stringstream result;
+			int height = 0, width = 0;
+
+			TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
+
+			SDL_GetWindowSize(m_window, &width, &height);
+			result << std::left << std::setw(COLUMN_WIDTH) << "Backend" << "SDL"
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Dimensions" << width << ", " << height;
+
+			TRACE_EXIT();
+			return result.str();
+		}
+
+		void
+		sdl::create(
+			__in const std::string &title,
+			__in bool crt
+			)
+		{
+			TRACE_ENTRY_FORMAT("Title[%u]=%s, CRT filter=%x", title.size(), STRING_CHECK(title), crt);
+
+			m_crt = crt;
+			create_window(title);
+
+			try {
+				m_bitmap_border.load(POST_PROCESS_BORDER_PATH);
+
+				m_texture_border = SDL_CreateTextureFromSurface(m_renderer, m_bitmap_border.surface());
+				if(!m_texture_border) {
+					TRACE_MESSAGE_FORMAT(TRACE_WARNING, "SDL_CreateTextureFromSurface failed!", "Error=%s", SDL_GetError());
+				}
+			} catch(...) { }
+
+			try {
+				m_bitmap_halt.load(POST_PROCESS_HALT_PATH);
+
+				m_texture_halt = SDL_CreateTextureFromSurface(m_renderer, m_bitmap_halt.surface());
+				if(!m_texture_halt) {
+					TRACE_MESSAGE_FORMAT(TRACE_WARNING, "SDL_CreateTextureFromSurface failed!", "Error=%s", SDL_GetError());
+				}
+			} catch(...) { }
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::create_texture(void)
+		{
+			TRACE_ENTRY();
+
+			if(SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, m_crt ? DISPLAY_QUALITY_CRT : DISPLAY_QUALITY) == SDL_FALSE) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_SetHint failed! Error=%s", SDL_GetError());
+			}
+
+			m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+					DISPLAY_WIDTH * m_scale, DISPLAY_HEIGHT * m_scale);
+
+			if(!m_texture) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_CreateTexture failed! Error=%s", SDL_GetError());
+			}
+
+			m_redraw = true;
+			m_texture_dirty = true;
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::create_window(
+			__in const std::string &title
+			)
+		{
+			TRACE_ENTRY_FORMAT("Title[%u]=%s", title.size(), STRING_CHECK(title));
+
+			m_window = SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+					DISPLAY_WIDTH_STRETCH * DISPLAY_SCALE, DISPLAY_HEIGHT * DISPLAY_SCALE, DISPLAY_FLAG);
+
+			if(!m_window) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_CreateWindow failed! Error=%s", SDL_GetError());
+			}
+
+			m_renderer = SDL_CreateRenderer(m_window, -1, DISPLAY_FLAG_RENDERER);
+			if(!m_renderer) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_CreateRenderer failed! Error=%s", SDL_GetError());
+			}
+
+			if(SDL_RenderSetLogicalSize(m_renderer, DISPLAY_WIDTH_STRETCH, DISPLAY_HEIGHT)) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_RenderSetLogicalSize failed! Error=%s", SDL_GetError());
+			}
+
+			if(SDL_SetRenderDrawColor(m_renderer, BACKGROUND_RED, BACKGROUND_GREEN, BACKGROUND_BLUE, BACKGROUND_ALPHA)) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_SetRenderDrawColor failed! Error=%s", SDL_GetError());
+			}
+
+			create_texture();
+
+			if(SDL_RenderClear(m_renderer)) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_RenderClear failed! Error=%s", SDL_GetError());
+			}
+
+			SDL_RenderPresent(m_renderer);
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::destroy(void)
+		{
+			TRACE_ENTRY();
+
+			if(m_texture_halt) {
+				SDL_DestroyTexture(m_texture_halt);
+				m_texture_halt = nullptr;
+			}
+
+			m_bitmap_halt.deallocate();
+
+			if(m_texture_border) {
+				SDL_DestroyTexture(m_texture_border);
+				m_texture_border = nullptr;
+			}
+
+			m_bitmap_border.deallocate();
+
+			destroy_window();
+			m_crt = false;
+			m_scale = 1;
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::destroy_texture(void)
+		{
+			TRACE_ENTRY();
+
+			if(m_texture) {
+				SDL_DestroyTexture(m_texture);
+				m_texture = nullptr;
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::destroy_window(void)
+		{
+			TRACE_ENTRY();
+
+			destroy_texture();
+
+			if(m_renderer) {
+				SDL_DestroyRenderer(m_renderer);
+				m_renderer = nullptr;
+			}
+
+			if(m_window) {
+				SDL_DestroyWindow(m_window);
+				m_window = nullptr;
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::present(
+			__in const std::vector<nescc::core::pixel_t> &pixel,
+			__in bool halted,
+			__in bool paused,
+			__in bool changed,
+			__in bool border
+			)
+		{
+			bool presented = false;
+			uint32_t width = (DISPLAY_WIDTH * m_scale);
+
+			TRACE_ENTRY_FORMAT("Pixel[%u]=%p, Halted=%x, Paused=%x, Changed=%x, Border=%x", pixel.size(), &pixel[0], halted,
+				paused, changed, border);
+
+			if(halted) {
+
+				if(SDL_RenderClear(m_renderer)) {
+					THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+						"SDL_RenderClear failed! Error=%s", SDL_GetError());
+				}
+
+				if(m_texture_halt) {
+
+					if(SDL_RenderCopy(m_renderer, m_texture_halt, nullptr, nullptr)) {
+						THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+							"SDL_RenderCopy failed! Error=%s", SDL_GetError());
+					}
+				}
+
+				m_redraw = true;
+				presented = true;
+			} else {
+
+				if(!paused && m_texture) {
+
+					// a frame identical to the one the texture already holds is not uploaded again
+					if(m_texture_dirty || changed) {
+#if DISPLAY_TEXTURE_LOCK
+						int pitch = 0;
+						uint8_t *texture = nullptr;
+						uint32_t height = (DISPLAY_HEIGHT * m_scale);
+
+						// the frame is streamed straight into the texture's own memory, which may pad each row past the
+						// frame width, rather than handed to the driver for a staging copy
+						if(SDL_LockTexture(m_texture, nullptr, (void **) &texture, &pitch)) {
+							THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+								"SDL_LockTexture failed! Error=%s", SDL_GetError());
+						}
+
+						if(pitch == (int) (width * sizeof(uint32_t))) {
+							std::memcpy(texture, &pixel[0], height * pitch);
+						} else {
+
+							for(uint32_t y = 0; y < height; ++y) {
+								std::memcpy(&texture[y * pitch], &pixel[y * width], width * sizeof(uint32_t));
+							}
+						}
+
+						SDL_UnlockTexture(m_texture);
+#else
+						if(SDL_UpdateTexture(m_texture, nullptr, &pixel[0], width * sizeof(uint32_t))) {
+							THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+								"SDL_UpdateTexture failed! Error=%s", SDL_GetError());
+						}
+#endif // DISPLAY_TEXTURE_LOCK
+
+						m_redraw = true;
+						m_texture_dirty = false;
+					}
+				}
+
+				// an unchanged frame is not drawn again, and in low-power mode neither is the window while paused
+				if(m_redraw || (paused && !m_low_power)) {
+
+					if(m_texture) {
+
+						if(SDL_RenderClear(m_renderer)) {
+							THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+								"SDL_RenderClear failed! Error=%s", SDL_GetError());
+						}
+
+						if(SDL_RenderCopy(m_renderer, m_texture, nullptr, nullptr)) {
+							THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+								"SDL_RenderCopy failed! Error=%s", SDL_GetError());
+						}
+					}
+
+					if(border && m_texture_border) {
+
+						if(SDL_RenderCopy(m_renderer, m_texture_border, nullptr, nullptr)) {
+							THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+								"SDL_RenderCopy failed! Error=%s", SDL_GetError());
+						}
+					}
+
+					m_redraw = false;
+					presented = true;
+				}
+			}
+
+			if(presented) {
+				SDL_RenderPresent(m_renderer);
+			}
+
+			// the window's events are pumped on the thread that presents it, the runtime only drains the event queue
+			SDL_PumpEvents();
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::set_filter(
+			__in bool crt
+			)
+		{
+			TRACE_ENTRY_FORMAT("CRT filter=%x", crt);
+
+			if(crt != m_crt) {
+				m_crt = crt;
+
+				if(m_window) {
+					destroy_texture();
+					create_texture();
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::set_fullscreen(
+			__in bool fullscreen
+			)
+		{
+			TRACE_ENTRY_FORMAT("Fullscreen=%x", fullscreen);
+
+			if(SDL_SetWindowFullscreen(m_window, fullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0)) {
+				THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL,
+					"SDL_SetWindowFullscreen failed! Error=%s", SDL_GetError());
+			}
+
+			SDL_ShowCursor(!fullscreen ? SDL_ENABLE : SDL_DISABLE);
+			m_redraw = true;
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::set_icon(
+			__in const std::string &path
+			)
+		{
+			SDL_Surface *surface;
+
+			TRACE_ENTRY_FORMAT("Path[%u]=%s", path.size(), STRING_CHECK(path));
+
+			surface = SDL_LoadBMP(path.c_str());
+			if(surface) {
+				SDL_SetWindowIcon(m_window, surface);
+
+				if(surface) {
+					SDL_FreeSurface(surface);
+					surface = nullptr;
+				}
+			} else {
+				TRACE_MESSAGE_FORMAT(TRACE_WARNING, "SDL_LoadBMP failed!", "Error=%s", SDL_GetError());
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::set_low_power(
+			__in bool low_power
+			)
+		{
+			TRACE_ENTRY_FORMAT("Low-power=%x", low_power);
+
+			m_low_power = low_power;
+			m_redraw = true;
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::set_scale(
+			__in uint32_t scale
+			)
+		{
+			TRACE_ENTRY_FORMAT("Scale=%u", scale);
+
+			if(scale != m_scale) {
+				m_scale = scale;
+
+				if(m_window) {
+					destroy_texture();
+					create_texture();
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::set_title(
+			__in const std::string &title
+			)
+		{
+			TRACE_ENTRY_FORMAT("Title[%u]=%s", title.size(), STRING_CHECK(title));
+
+			SDL_SetWindowTitle(m_window, title.c_str());
+
+			TRACE_EXIT();
+		}
+
+		void
+		sdl::show(
+			__in bool shown
+			)
+		{
+			TRACE_ENTRY_FORMAT("Shown=%x", shown);
+
+			if(shown) {
+				SDL_ShowWindow(m_window);
+			} else {
+				SDL_HideWindow(m_window);
+			}
+
+			m_redraw = true;
+
+			TRACE_EXIT();
+		}
+
+		std::string
+		sdl::to_string(
+			__in_opt bool verbose
+			) const
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
+
+			result << NESCC_BACKEND_SDL_HEADER << "(" << SCALAR_AS_HEX(uintptr_t, this) << ")";
+
+			if(verbose) {
+				result << " Window=" << SCALAR_AS_HEX(uintptr_t, m_window)
+					<< ", Renderer=" << SCALAR_AS_HEX(uintptr_t, m_renderer)
+					<< ", Texture=" << SCALAR_AS_HEX(uintptr_t, m_texture)
+						<< "(" << (DISPLAY_WIDTH * m_scale) << "x" << (DISPLAY_HEIGHT * m_scale)
+						<< ", " << (m_texture_dirty ? "Dirty" : "Clean") << ")"
+					<< ", Mode=" << (m_low_power ? "Low-power" : "Full-power");
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+	}
+}
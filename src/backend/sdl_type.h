@@ -0,0 +1,72 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_BACKEND_SDL_TYPE_H_
+#define NESCC_BACKEND_SDL_TYPE_H_
+
+#include "../../include/exception.h"
+
+namespace nescc {
+
+	namespace backend {
+
+		#define NESCC_BACKEND_SDL_HEADER "[NESCC::BACKEND::SDL]"
+#ifndef NDEBUG
+		#define NESCC_BACKEND_SDL_EXCEPTION_HEADER NESCC_BACKEND_SDL_HEADER " "
+#else
+		#define NESCC_BACKEND_SDL_EXCEPTION_HEADER
+#endif // NDEBUG
+
+		enum {
+			NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL = 0,
+		};
+
+		#define NESCC_BACKEND_SDL_EXCEPTION_MAX NESCC_BACKEND_SDL_EXCEPTION_EXTERNAL
+
+		static const std::string NESCC_BACKEND_SDL_EXCEPTION_STR[] = {
+			NESCC_BACKEND_SDL_EXCEPTION_HEADER "External sdl backend exception",
+			};
+
+		#define NESCC_BACKEND_SDL_EXCEPTION_STRING(_TYPE_) \
+			(((_TYPE_) > NESCC_BACKEND_SDL_EXCEPTION_MAX) ? EXCEPTION_UNKNOWN : \
+				STRING_CHECK(NESCC_BACKEND_SDL_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_NESCC_BACKEND_SDL_EXCEPTION(_EXCEPT_) \
+			THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(_EXCEPT_, "", "")
+		#define THROW_NESCC_BACKEND_SDL_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_FORMAT(NESCC_BACKEND_SDL_EXCEPTION_STRING(_EXCEPT_), \
+				_FORMAT_, __VA_ARGS__)
+
+		#define DISPLAY_FLAG (SDL_WINDOW_RESIZABLE)
+		#define DISPLAY_FLAG_RENDERER (SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC)
+		#define DISPLAY_QUALITY "0" // nearest
+		#define DISPLAY_QUALITY_CRT "1" // linear
+		#define DISPLAY_SCALE 2
+
+#ifndef DISPLAY_TEXTURE_LOCK
+		#define DISPLAY_TEXTURE_LOCK 1
+#endif // DISPLAY_TEXTURE_LOCK
+
+		#define DISPLAY_WIDTH_STRETCH 320
+
+		#define POST_PROCESS_BORDER_PATH "./asset/border.bmp"
+		#define POST_PROCESS_HALT_PATH "./asset/halt.bmp"
+	}
+}
+
+#endif // NESCC_BACKEND_SDL_TYPE_H_
@@ -0,0 +1,46 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/core/hash.h"
+#include "../../include/trace.h"
+#include "./hash_type.h"
+
+namespace nescc {
+
+	namespace core {
+
+		uint64_t
+		hash::frame(
+			__in const std::vector<nescc::core::pixel_t> &pixel
+			)
+		{
+			uint64_t result = HASH_BASIS;
+			std::vector<nescc::core::pixel_t>::const_iterator iter;
+
+			TRACE_ENTRY_FORMAT("Pixel[%u]=%p", pixel.size(), &pixel[0]);
+
+			for(iter = pixel.begin(); iter != pixel.end(); ++iter) {
+				result ^= iter->raw;
+				result *= HASH_PRIME;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%016llx", result);
+			return result;
+		}
+	}
+}
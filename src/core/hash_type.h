@@ -0,0 +1,30 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NESCC_CORE_HASH_TYPE_H_
+#define NESCC_CORE_HASH_TYPE_H_
+
+namespace nescc {
+
+	namespace core {
+
+		#define HASH_PRIME 0x100000001b3ULL
+	}
+}
+
+#endif // NESCC_CORE_HASH_TYPE_H_
@@ -0,0 +1,134 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/core/worker.h"
+#include "../../include/trace.h"
+#include "./worker_type.h"
+
+namespace nescc {
+
+	namespace core {
+
+		worker::worker(void) :
+			m_band(nullptr),
+			m_begin(0),
+			m_end(0),
+			m_index(0)
+		{
+			TRACE_ENTRY();
+			TRACE_EXIT();
+		}
+
+		worker::~worker(void)
+		{
+			TRACE_ENTRY();
+
+			stop();
+
+			TRACE_EXIT();
+		}
+
+		void
+		worker::dispatch(
+			__in nescc::interface::band &band,
+			__in uint32_t index,
+			__in uint16_t begin,
+			__in uint16_t end
+			)
+		{
+			TRACE_ENTRY_FORMAT("Band=%p, Index=%u, Rows=[%u, %u)", &band, index, begin, end);
+
+			if(m_band) {
+				THROW_NESCC_CORE_WORKER_EXCEPTION_FORMAT(NESCC_CORE_WORKER_EXCEPTION_BUSY, "Band=%u", m_index);
+			}
+
+			m_band = &band;
+			m_begin = begin;
+			m_end = end;
+			m_index = index;
+			notify();
+
+			TRACE_EXIT();
+		}
+
+		bool
+		worker::on_run(void)
+		{
+			bool result = true;
+
+			TRACE_ENTRY();
+
+			if(m_band) {
+
+				// completion is signalled even if the band throws, so a synchronizing caller never waits on a dead worker
+				try {
+					m_band->on_band(m_index, m_begin, m_end);
+				} catch(...) {
+					m_signal_complete.notify();
+					throw;
+				}
+
+				m_signal_complete.notify();
+			}
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		void
+		worker::synchronize(void)
+		{
+			TRACE_ENTRY();
+
+			if(m_band) {
+				m_signal_complete.wait();
+				m_band = nullptr;
+
+				if(stopped()) {
+					THROW_NESCC_CORE_WORKER_EXCEPTION_FORMAT(NESCC_CORE_WORKER_EXCEPTION_FAILED, "%s",
+						STRING_CHECK(m_exception.to_string(true)));
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		std::string
+		worker::to_string(
+			__in_opt bool verbose
+			) const
+		{
+			std::stringstream result;
+
+			TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
+
+			result << NESCC_CORE_WORKER_HEADER << "(" << SCALAR_AS_HEX(uintptr_t, this) << ")";
+
+			if(verbose) {
+				result << " Base=" << nescc::core::thread::to_string(verbose);
+
+				if(m_band) {
+					result << ", Band=" << m_index << " [" << m_begin << ", " << m_end << ")";
+				}
+			}
+
+			TRACE_EXIT();
+			return result.str();
+		}
+	}
+}
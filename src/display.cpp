@@ -16,28 +16,50 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstring>
+#include "../include/core/hash.h"
 #include "../include/display.h"
 #include "../include/runtime.h"
 #include "../include/trace.h"
 #include "./display_type.h"
 
+#if POST_PROCESS_SIMD && defined(__SSE2__)
+#include <immintrin.h>
+#endif // POST_PROCESS_SIMD && __SSE2__
+
 namespace nescc {
 
 	display::display(void) :
-		m_crt(false),
-		m_crt_bleed(true),
-		m_crt_border(true),
+		m_backend(&m_backend_sdl),
+		m_band_frame(nullptr),
+		m_band_stage(DISPLAY_BAND_CRT),
+		m_crt(DISPLAY_CRT_SETTING(false, true, true, true)),
 		m_crt_frame(0),
-		m_crt_scanlines(true),
+		m_crt_offset(0),
+		m_crt_previous(false),
 		m_debug(false),
+		m_frame_present(0),
+		m_frame_ready(0),
+		m_frame_write(0),
 		m_fullscreen(false),
 		m_halted(false),
-		m_renderer(nullptr),
+		m_low_power(false),
+		m_present_close(false),
+		m_present_created(false),
+		m_present_crt(0),
+		m_present_hash(HASH_BASIS),
+		m_present_low_power(false),
+		m_present_scale(POST_PROCESS_SCALE_DEFAULT),
+		m_present_scaler(POST_PROCESS_SCALER_DEFAULT),
+		m_scale(DISPLAY_SCALE_SETTING(POST_PROCESS_SCALE_DEFAULT, POST_PROCESS_SCALER_DEFAULT)),
+		m_scale_factor(POST_PROCESS_SCALE_DEFAULT),
+		m_scale_height(0),
+		m_scale_source(nullptr),
+		m_scale_target(nullptr),
+		m_scale_width(0),
 		m_shown(false),
-		m_texture(nullptr),
-		m_texture_border(nullptr),
-		m_texture_halt(nullptr),
-		m_window(nullptr)
+		m_worker_count(0)
 	{
 		TRACE_ENTRY();
 		TRACE_EXIT();
@@ -55,14 +77,12 @@ namespace nescc {
 		) const
 	{
 		std::stringstream result;
-		int height = 0, width = 0;
 
 		TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
 
-		SDL_GetWindowSize(m_window, &width, &height);
-		result << std::left << std::setw(COLUMN_WIDTH) << "Dimensions" << width << ", " << height
+		result << m_backend->as_string(verbose)
 			<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "CRT filter"
-				<< (m_crt ? "Enabled" : "Disabled")
+				<< ((m_crt & DISPLAY_CRT_ENABLED) ? "Enabled" : "Disabled")
 			<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "State" << (m_shown ? "Shown" : "Hidden")
 				<< "/" << (m_fullscreen ? "Fullscreen" : "Window")
 				<< "/" << (m_halted ? "Halted" : "Running")
@@ -72,6 +92,29 @@ namespace nescc {
 		return result.str();
 	}
 
+	nescc::interface::backend &
+	display::backend(void)
+	{
+		TRACE_ENTRY();
+
+#ifndef NDEBUG
+		if(!m_initialized) {
+			THROW_NESCC_DISPLAY_EXCEPTION(NESCC_DISPLAY_EXCEPTION_UNINITIALIZED);
+		}
+#endif // NDEBUG
+
+		TRACE_EXIT_FORMAT("Result=%p", m_backend);
+		return *m_backend;
+	}
+
+	nescc::backend::headless &
+	display::backend_headless(void)
+	{
+		TRACE_ENTRY();
+		TRACE_EXIT_FORMAT("Result=%p", &m_backend_headless);
+		return m_backend_headless;
+	}
+
 	void
 	display::clear(void)
 	{
@@ -91,207 +134,278 @@ namespace nescc {
 	}
 
 	void
-	display::create_texture(void)
+	display::create_backend(void)
 	{
 		TRACE_ENTRY();
 
-		if(SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, m_crt ? DISPLAY_QUALITY_CRT : DISPLAY_QUALITY) == SDL_FALSE) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_SetHint failed! Error=%s", SDL_GetError());
-		}
-
-		m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
-				DISPLAY_WIDTH, DISPLAY_HEIGHT);
-
-		if(!m_texture) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_CreateTexture failed! Error=%s", SDL_GetError());
+		if(headless()) {
+			m_present_crt = m_crt;
+			m_present_low_power = m_low_power;
+			m_backend->create(m_title, m_present_crt & DISPLAY_CRT_ENABLED);
+			m_backend->set_low_power(m_present_low_power);
+			m_present_scale = POST_PROCESS_SCALE_DEFAULT;
+		} else {
+			m_frame_present = 0;
+			m_frame_ready = 1;
+			m_frame_write = 2;
+			m_present_close = false;
+			m_present_created = false;
+
+			// the backend is created, presented and destroyed on the presenter thread, since the renderer is only
+			// usable from the thread that created it, and the window's events are pumped there too, so window
+			// operations are queued to it
+			nescc::core::thread::start();
+			nescc::core::thread::notify();
+			m_signal_present.wait();
+
+			if(!m_present_created) {
+				nescc::core::thread::stop();
+				THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_PRESENT, "%s",
+					STRING_CHECK(m_exception.to_string(true)));
+			}
 		}
 
 		TRACE_EXIT();
 	}
 
 	void
-	display::create_window(void)
+	display::destroy_backend(void)
 	{
 		TRACE_ENTRY();
 
-		m_window = SDL_CreateWindow(m_title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-				DISPLAY_WIDTH_STRETCH * DISPLAY_SCALE, DISPLAY_HEIGHT * DISPLAY_SCALE, DISPLAY_FLAG);
-
-		if(!m_window) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_CreateWindow failed! Error=%s", SDL_GetError());
-		}
-
-		m_renderer = SDL_CreateRenderer(m_window, -1, DISPLAY_FLAG_RENDERER);
-		if(!m_renderer) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_CreateRenderer failed! Error=%s", SDL_GetError());
-		}
+		if(headless()) {
+			m_backend->destroy();
+		} else {
 
-		if(SDL_RenderSetLogicalSize(m_renderer, DISPLAY_WIDTH_STRETCH, DISPLAY_HEIGHT)) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_RenderSetLogicalSize failed! Error=%s", SDL_GetError());
-		}
+			if(nescc::core::thread::running()) {
+				m_present_close = true;
+				nescc::core::thread::notify();
+				m_signal_present.wait();
+			}
 
-		if(SDL_SetRenderDrawColor(m_renderer, BACKGROUND_RED, BACKGROUND_GREEN, BACKGROUND_BLUE, BACKGROUND_ALPHA)) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_SetRenderDrawColor failed! Error=%s", SDL_GetError());
-		}
+			nescc::core::thread::stop();
 
-		create_texture();
+			if(m_present_created) {
+				m_backend->destroy();
+				m_present_created = false;
+			}
 
-		if(SDL_RenderClear(m_renderer)) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_RenderClear failed! Error=%s", SDL_GetError());
+			// window operations still queued for the destroyed window are dropped
+			std::lock_guard<std::mutex> lock(m_window_mutex);
+			m_window.clear();
 		}
 
-		SDL_RenderPresent(m_renderer);
-		m_shown = true;
-
 		TRACE_EXIT();
 	}
 
 	void
-	display::destroy_texture(void)
+	display::filter_crt(
+		__inout std::vector<nescc::core::pixel_t> &frame
+		)
 	{
 		TRACE_ENTRY();
 
-		if(m_texture) {
-			SDL_DestroyTexture(m_texture);
-			m_texture = nullptr;
-		}
+		m_crt_previous = false;
 
-		TRACE_EXIT();
-	}
-
-	void
-	display::destroy_window(void)
-	{
-		TRACE_ENTRY();
-
-		m_shown = false;
+		if(m_present_crt & DISPLAY_CRT_SCANLINES) {
+			m_crt_offset = (std::rand() % POST_PROCESS_SIGNAL_ARTIFACT_WIDTH);
+		}
 
-		destroy_texture();
+		if(m_present_crt & DISPLAY_CRT_BLEED) {
 
-		if(m_renderer) {
-			SDL_DestroyRenderer(m_renderer);
-			m_renderer = nullptr;
+			m_crt_previous = (++m_crt_frame == POST_PROCESS_BLEED);
+			if(m_crt_previous) {
+				m_crt_frame = 0;
+			}
 		}
 
-		if(m_window) {
-			SDL_DestroyWindow(m_window);
-			m_window = nullptr;
-		}
+		m_band_frame = &frame;
+		process_bands(DISPLAY_BAND_CRT, DISPLAY_HEIGHT);
+		m_band_frame = nullptr;
 
 		TRACE_EXIT();
 	}
 
 	void
-	display::filter_crt(void)
+	display::filter_crt_band(
+		__in uint32_t index,
+		__in uint16_t begin,
+		__in uint16_t end
+		)
 	{
-		int32_t pixel_x, pixel_y;
-
-		TRACE_ENTRY();
+		bool previous = m_crt_previous;
+		uint32_t offset = m_crt_offset;
+		uint16_t pixel_x, pixel_y;
+		const uint8_t *blend_bleed = &m_crt_blend_bleed[0], *blend_scanline = &m_crt_blend_scanline[0];
+		std::vector<nescc::core::pixel_t> &frame = *m_band_frame;
+
+		TRACE_ENTRY_FORMAT("Band[%u]=[%u, %u)", index, begin, end);
+
+		// each row is filtered in two passes: scanline artifacts are applied into the band's scratch line, which is padded
+		// with the neighbors the bleed sweep wraps to (254 to the left of 0, 1 to the right of 255), then the previous
+		// frame is blended in and the red channel is swept from the right and the green and blue channels from the left
+		for(pixel_y = begin; pixel_y < end; ++pixel_y) {
+			uint32_t *line = &m_crt_line[(index * (DISPLAY_WIDTH + 2)) + 1], *row = &frame[pixel_y * DISPLAY_WIDTH].raw,
+				*row_previous = &m_pixel_previous[pixel_y * DISPLAY_WIDTH].raw;
+			const uint32_t *artifact = &m_crt_artifact[((pixel_y + offset) % POST_PROCESS_SIGNAL_ARTIFACT_WIDTH)
+				* DISPLAY_WIDTH];
+
+			if(m_present_crt & DISPLAY_CRT_SCANLINES) {
+#if POST_PROCESS_SIMD && defined(__AVX2__)
+				__m256i mask_alpha = _mm256_set1_epi32(POST_PROCESS_MASK_ALPHA),
+					mask_channel = _mm256_set1_epi32(UINT8_MAX);
+
+				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; pixel_x += POST_PROCESS_SIMD_WIDTH_AVX2) {
+					__m256i noise = _mm256_loadu_si256((const __m256i *) &artifact[pixel_x]),
+						value = _mm256_loadu_si256((const __m256i *) &row[pixel_x]),
+						result = _mm256_and_si256(mask_alpha, value);
+
+					for(uint8_t channel = 0; channel < POST_PROCESS_CHANNEL_MAX; ++channel) {
+						uint8_t shift = (channel * CHAR_BIT);
+
+						result = _mm256_or_si256(result, _mm256_slli_epi32(POST_PROCESS_BLEND_AVX2(blend_scanline,
+							value, noise, shift, mask_channel), shift));
+					}
 
-		if(m_crt_scanlines) {
-			uint32_t index, offset = (std::rand() % POST_PROCESS_SIGNAL_ARTIFACT_WIDTH);
+					_mm256_storeu_si256((__m256i *) &line[pixel_x], result);
+				}
+#else
+				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
+					uint32_t noise = artifact[pixel_x], value = row[pixel_x];
 
-			for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+					line[pixel_x] = (value & POST_PROCESS_MASK_ALPHA);
 
-				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
-					index = ((pixel_y * DISPLAY_WIDTH) + pixel_x);
-					nescc::core::pixel_t artifact = POST_PROCESS_SIGNAL_ARTIFACT(pixel_x, pixel_y, offset),
-						&value = m_pixel.at(index);
+					for(uint8_t channel = 0; channel < POST_PROCESS_CHANNEL_MAX; ++channel) {
+						uint8_t shift = (channel * CHAR_BIT);
 
-					value.red = PIXEL_BLEND(value.red, artifact.red, POST_PROCESS_SCANLINE_ARTIFACT_RATIO);
-					value.green = PIXEL_BLEND(value.green, artifact.green, POST_PROCESS_SCANLINE_ARTIFACT_RATIO);
-					value.blue = PIXEL_BLEND(value.blue, artifact.blue, POST_PROCESS_SCANLINE_ARTIFACT_RATIO);
+						line[pixel_x] |= (blend_scanline[POST_PROCESS_BLEND_INDEX((value >> shift) & UINT8_MAX,
+							(noise >> shift) & UINT8_MAX)] << shift);
+					}
 				}
+#endif // POST_PROCESS_SIMD && __AVX2__
+			} else {
+				std::memcpy(line, row, DISPLAY_WIDTH * sizeof(uint32_t));
 			}
-		}
 
-		if(m_crt_bleed) {
-			uint32_t index, pixel, pixel_tmp;
-			std::vector<nescc::core::pixel_t> pixel_left = m_pixel, pixel_right = m_pixel;
+			if(m_present_crt & DISPLAY_CRT_BLEED) {
+				line[-1] = line[DISPLAY_WIDTH - 2];
+				line[DISPLAY_WIDTH] = line[1];
+
+#if POST_PROCESS_SIMD && defined(__AVX2__)
+				__m256i mask_alpha = _mm256_set1_epi32(POST_PROCESS_MASK_ALPHA),
+					mask_channel = _mm256_set1_epi32(UINT8_MAX),
+					mask_green_blue = _mm256_set1_epi32(POST_PROCESS_MASK_GREEN_BLUE),
+					mask_red = _mm256_set1_epi32(POST_PROCESS_MASK_RED),
+					weight_sweep = _mm256_set1_epi32(POST_PROCESS_BLEED_SWEEP_WEIGHT);
+
+				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; pixel_x += POST_PROCESS_SIMD_WIDTH_AVX2) {
+					__m256i neighbor = _mm256_or_si256(
+							_mm256_and_si256(mask_red, _mm256_loadu_si256((const __m256i *) &line[pixel_x + 1])),
+							_mm256_and_si256(mask_green_blue, _mm256_loadu_si256((const __m256i *) &line[pixel_x - 1]))),
+						value = _mm256_loadu_si256((const __m256i *) &line[pixel_x]),
+						value_previous = _mm256_loadu_si256((const __m256i *) &row_previous[pixel_x]),
+						result = _mm256_and_si256(mask_alpha, value);
+
+					for(uint8_t channel = 0; channel < POST_PROCESS_CHANNEL_MAX; ++channel) {
+						uint8_t shift = (channel * CHAR_BIT);
+
+						result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_srli_epi32(_mm256_add_epi32(
+							_mm256_mullo_epi32(POST_PROCESS_BLEND_AVX2(blend_bleed, value, value_previous, shift,
+								mask_channel), weight_sweep),
+							_mm256_and_si256(_mm256_srli_epi32(neighbor, shift), mask_channel)),
+							POST_PROCESS_BLEED_SWEEP_SHIFT), shift));
+					}
 
-			for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+					_mm256_storeu_si256((__m256i *) &row[pixel_x], result);
 
+					if(previous) {
+						_mm256_storeu_si256((__m256i *) &row_previous[pixel_x], result);
+					}
+				}
+#else
 				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
-					index = ((pixel_y * DISPLAY_WIDTH) + pixel_x);
-					nescc::core::pixel_t &value = m_pixel.at(index), &value_previous = m_pixel_previous.at(index);
+					uint32_t neighbor = ((line[pixel_x + 1] & POST_PROCESS_MASK_RED)
+							| (line[pixel_x - 1] & POST_PROCESS_MASK_GREEN_BLUE)),
+						value = line[pixel_x], value_previous = row_previous[pixel_x];
 
-					value.red = PIXEL_BLEND(value.red, value_previous.red, POST_PROCESS_BLEED_RATIO);
-					value.green = PIXEL_BLEND(value.green, value_previous.green, POST_PROCESS_BLEED_RATIO);
-					value.blue = PIXEL_BLEND(value.blue, value_previous.blue, POST_PROCESS_BLEED_RATIO);
-				}
-			}
+					row[pixel_x] = (value & POST_PROCESS_MASK_ALPHA);
 
-			for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+					for(uint8_t channel = 0; channel < POST_PROCESS_CHANNEL_MAX; ++channel) {
+						uint8_t shift = (channel * CHAR_BIT);
 
-				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
-					index = ((pixel_y * DISPLAY_WIDTH) + pixel_x);
-					nescc::core::pixel_t &value_left = pixel_left.at(index), &value_right = pixel_right.at(index);
+						row[pixel_x] |= ((((blend_bleed[POST_PROCESS_BLEND_INDEX((value >> shift) & UINT8_MAX,
+							(value_previous >> shift) & UINT8_MAX)] * POST_PROCESS_BLEED_SWEEP_WEIGHT)
+							+ ((neighbor >> shift) & UINT8_MAX)) >> POST_PROCESS_BLEED_SWEEP_SHIFT) << shift);
+					}
 
-					value_left.blue = 0;
-					value_left.green = 0;
-					value_right.red = 0;
+					if(previous) {
+						row_previous[pixel_x] = row[pixel_x];
+					}
 				}
+#endif // POST_PROCESS_SIMD && __AVX2__
+			} else {
+				std::memcpy(row, line, DISPLAY_WIDTH * sizeof(uint32_t));
 			}
+		}
 
-			for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+		TRACE_EXIT();
+	}
 
-				for(pixel_x = (DISPLAY_WIDTH - 1); pixel_x >= 0; --pixel_x) {
-					index = ((pixel_y * DISPLAY_WIDTH) + pixel_x);
+	void
+	display::generate_blend(
+		__inout std::vector<uint8_t> &table,
+		__in double ratio
+		)
+	{
+		TRACE_ENTRY_FORMAT("Table=%p, Ratio=%.02f", &table, ratio);
 
-					if(!pixel_x) {
-						pixel_left.at(index + (DISPLAY_WIDTH - 1)).raw = pixel_left.at(index).raw;
-					} else if(pixel_x == (DISPLAY_WIDTH - 1)) {
-						pixel = pixel_left.at(index - 1).raw;
-						pixel_left.at(index - 1).raw = pixel_left.at(index).raw;
-					} else {
-						pixel_tmp = pixel_left.at(index - 1).raw;
-						pixel_left.at(index - 1).raw = pixel;
-						pixel = pixel_tmp;
-					}
-				}
-			}
+		table.assign(POST_PROCESS_BLEND_LENGTH + POST_PROCESS_BLEND_PADDING, 0);
 
-			for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+		// the blend is tabulated from the filter's floating-point ratio, with each product stored before the sum, so the
+		// compiler cannot fuse them and every value is truncated exactly as the per-pixel blend always was
+		for(uint32_t left = 0; left <= UINT8_MAX; ++left) {
 
-				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
-					index = ((pixel_y * DISPLAY_WIDTH) + pixel_x);
+			for(uint32_t right = 0; right <= UINT8_MAX; ++right) {
+				volatile double value_left = (ratio * left), value_right = ((1.0 - ratio) * right);
 
-					if(pixel_x == (DISPLAY_WIDTH - 1)) {
-						pixel_right.at(index - (DISPLAY_WIDTH - 1)).raw = pixel_right.at(index).raw;
-					} else if(!pixel_x) {
-						pixel = pixel_right.at(index + 1).raw;
-						pixel_right.at(index + 1).raw = pixel_right.at(index).raw;
-					} else {
-						pixel_tmp = pixel_right.at(index + 1).raw;
-						pixel_right.at(index + 1).raw = pixel;
-						pixel = pixel_tmp;
-					}
-				}
+				table[POST_PROCESS_BLEND_INDEX(left, right)] = (value_left + value_right);
 			}
+		}
 
-			for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+		TRACE_EXIT();
+	}
 
-				for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
-					index = ((pixel_y * DISPLAY_WIDTH) + pixel_x);
-					nescc::core::pixel_t &value = m_pixel.at(index), &value_left = pixel_left.at(index),
-						&value_right = pixel_right.at(index);
-					value.red = PIXEL_BLEND(value.red, value_left.red + value_right.red, POST_PROCESS_BLEED_SWEEP_RATIO);
-					value.green = PIXEL_BLEND(value.green, value_left.green + value_right.green, POST_PROCESS_BLEED_SWEEP_RATIO);
-					value.blue = PIXEL_BLEND(value.blue, value_left.blue + value_right.blue, POST_PROCESS_BLEED_SWEEP_RATIO);
-				}
-			}
+	bool
+	display::headless(void) const
+	{
+		bool result;
 
-			if(++m_crt_frame == POST_PROCESS_BLEED) {
-				m_pixel_previous = m_pixel;
-				m_crt_frame = 0;
-			}
+		TRACE_ENTRY();
+
+		result = (m_backend == &m_backend_headless);
+
+		TRACE_EXIT_FORMAT("Result=%x", result);
+		return result;
+	}
+
+	void
+	display::on_band(
+		__in uint32_t index,
+		__in uint16_t begin,
+		__in uint16_t end
+		)
+	{
+		TRACE_ENTRY_FORMAT("Band[%u]=[%u, %u)", index, begin, end);
+
+		switch(m_band_stage) {
+			case DISPLAY_BAND_CRT:
+				filter_crt_band(index, begin, end);
+				break;
+			case DISPLAY_BAND_SCALE:
+				scale_band(index, begin, end);
+				break;
+			default:
+				break;
 		}
 
 		TRACE_EXIT();
@@ -311,27 +425,78 @@ namespace nescc {
 		m_title = title.str();
 		m_pixel.resize(DISPLAY_WIDTH * DISPLAY_HEIGHT, {});
 		m_pixel_previous.resize(DISPLAY_WIDTH * DISPLAY_HEIGHT, {});
-		create_window();
 
-		try {
-			m_bitmap_border.load(POST_PROCESS_BORDER_PATH);
+		for(uint32_t frame = 0; frame < DISPLAY_FRAME_COUNT; ++frame) {
+			m_frame[frame].resize(DISPLAY_WIDTH * DISPLAY_HEIGHT, {});
+		}
+
+		// the presenter filters the first band itself, so one core is left out of the pool
+		m_worker_count = std::thread::hardware_concurrency();
+		m_worker_count = std::min<uint32_t>(m_worker_count ? (m_worker_count - 1) : 0, POST_PROCESS_WORKER_MAX);
+
+		for(uint32_t worker = 0; worker < m_worker_count; ++worker) {
+			m_worker[worker].start();
+		}
+
+		// each band's scratch line carries one pixel of padding on either side
+		m_crt_artifact.resize(POST_PROCESS_SIGNAL_ARTIFACT_WIDTH * DISPLAY_WIDTH);
+		m_crt_line.resize((m_worker_count + 1) * (DISPLAY_WIDTH + 2), 0);
+
+		for(uint32_t index = 0; index < m_crt_artifact.size(); ++index) {
+			m_crt_artifact.at(index) = POST_PROCESS_SIGNAL_ARTIFACT(index % DISPLAY_WIDTH, index / DISPLAY_WIDTH, 0).raw;
+		}
+
+		generate_blend(m_crt_blend_bleed, POST_PROCESS_BLEED_RATIO);
+		generate_blend(m_crt_blend_scanline, POST_PROCESS_SCANLINE_ARTIFACT_RATIO);
+
+		create_backend();
+		m_shown = true;
+
+		TRACE_MESSAGE(TRACE_INFORMATION, "Display initialized.");
+
+		TRACE_EXIT_FORMAT("Result=%x", result);
+		return result;
+	}
 
-			m_texture_border = SDL_CreateTextureFromSurface(m_renderer, m_bitmap_border.surface());
-			if(!m_texture_border) {
-				TRACE_MESSAGE_FORMAT(TRACE_WARNING, "SDL_CreateTextureFromSurface failed!", "Error=%s", SDL_GetError());
+	bool
+	display::on_run(void)
+	{
+		bool result = true;
+
+		TRACE_ENTRY();
+
+		if(!m_present_created) {
+
+			try {
+				m_present_crt = m_crt;
+				m_present_low_power = m_low_power;
+				m_backend->create(m_title, m_present_crt & DISPLAY_CRT_ENABLED);
+				m_backend->set_low_power(m_present_low_power);
+				m_present_created = true;
+				m_present_scale = POST_PROCESS_SCALE_DEFAULT;
+			} catch(...) {
+				m_signal_present.notify();
+				throw;
 			}
-		} catch(...) { }
 
-		try {
-			m_bitmap_halt.load(POST_PROCESS_HALT_PATH);
+			m_signal_present.notify();
+		} else if(m_present_close) {
+			m_backend->destroy();
+			m_present_created = false;
+			m_signal_present.notify();
+			result = false;
+		} else {
+			bool fresh = (m_frame_ready & DISPLAY_FRAME_FRESH);
 
-			m_texture_halt = SDL_CreateTextureFromSurface(m_renderer, m_bitmap_halt.surface());
-			if(!m_texture_halt) {
-				TRACE_MESSAGE_FORMAT(TRACE_WARNING, "SDL_CreateTextureFromSurface failed!", "Error=%s", SDL_GetError());
+			// frames published since the last present are dropped in favor of the newest, and the last frame is
+			// presented again if nothing new was published
+			if(fresh) {
+				m_frame_present = (m_frame_ready.exchange(m_frame_present) & DISPLAY_FRAME_INDEX);
 			}
-		} catch(...) { }
 
-		TRACE_MESSAGE(TRACE_INFORMATION, "Display initialized.");
+			update_window();
+			present(m_frame[m_frame_present], fresh);
+		}
 
 		TRACE_EXIT_FORMAT("Result=%x", result);
 		return result;
@@ -344,30 +509,193 @@ namespace nescc {
 
 		TRACE_MESSAGE(TRACE_INFORMATION, "Display uninitializing...");
 
-		if(m_texture_halt) {
-			SDL_DestroyTexture(m_texture_halt);
-			m_texture_halt = nullptr;
-		}
-
-		m_bitmap_halt.deallocate();
+		destroy_backend();
 
-		if(m_texture_border) {
-			SDL_DestroyTexture(m_texture_border);
-			m_texture_border = nullptr;
+		for(uint32_t worker = 0; worker < m_worker_count; ++worker) {
+			m_worker[worker].stop();
 		}
 
-		m_bitmap_border.deallocate();
-
-		destroy_window();
+		m_worker_count = 0;
+		m_shown = false;
 		m_debug = false;
 		m_fullscreen = false;
 		m_halted = false;
+		m_low_power = false;
 
 		TRACE_MESSAGE(TRACE_INFORMATION, "Display uninitialized.");
 
 		TRACE_EXIT();
 	}
 
+	uint32_t *
+	display::line(
+		__in uint16_t y
+		)
+	{
+		uint32_t *result;
+
+		TRACE_ENTRY_FORMAT("Line=%u", y);
+
+#ifndef NDEBUG
+		if(!m_initialized) {
+			THROW_NESCC_DISPLAY_EXCEPTION(NESCC_DISPLAY_EXCEPTION_UNINITIALIZED);
+		}
+#endif // NDEBUG
+
+		if(y >= DISPLAY_HEIGHT) {
+			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_POSITION,
+				"Position={0, %u}", y);
+		}
+
+		result = &m_pixel.at(y * DISPLAY_WIDTH).raw;
+
+		TRACE_EXIT_FORMAT("Result=%p", result);
+		return result;
+	}
+
+	bool
+	display::low_power(void) const
+	{
+		bool result;
+
+		TRACE_ENTRY();
+
+		result = m_low_power;
+
+		TRACE_EXIT_FORMAT("Result=%x", result);
+		return result;
+	}
+
+	void
+	display::present(
+		__inout std::vector<nescc::core::pixel_t> &frame,
+		__in bool fresh
+		)
+	{
+		uint64_t hash;
+		uint32_t crt, scale;
+		bool border, changed = true, halted, low_power, refresh = false;
+
+		TRACE_ENTRY_FORMAT("Frame[%u]=%p, Fresh=%x", frame.size(), &frame[0], fresh);
+
+		// settings are written on the emulation thread, so each is read once, and only its snapshot is used below
+		crt = m_crt;
+		halted = m_halted;
+		low_power = m_low_power;
+		scale = m_scale;
+
+		if((crt & DISPLAY_CRT_ENABLED) != (m_present_crt & DISPLAY_CRT_ENABLED)) {
+			m_backend->set_filter(crt & DISPLAY_CRT_ENABLED);
+			m_crt_frame = 0;
+			m_pixel_previous.assign(frame.begin(), frame.end());
+			refresh = true;
+		}
+
+		m_present_crt = crt;
+		border = ((crt & DISPLAY_CRT_ENABLED) && (crt & DISPLAY_CRT_BORDER));
+
+		if(low_power != m_present_low_power) {
+			m_backend->set_low_power(low_power);
+			m_present_low_power = low_power;
+		}
+
+		if((DISPLAY_SCALE(scale) != m_present_scale) || (DISPLAY_SCALER(scale) != m_present_scaler)) {
+			m_present_scale = DISPLAY_SCALE(scale);
+			m_present_scaler = DISPLAY_SCALER(scale);
+			m_backend->set_scale(m_present_scale);
+			m_scale_frame.assign(DISPLAY_WIDTH * DISPLAY_HEIGHT * m_present_scale * m_present_scale, {});
+			m_scale_pass.clear();
+
+			if((m_present_scaler == POST_PROCESS_SCALER_EDGE)
+					&& (m_present_scale == (POST_PROCESS_SCALE_EDGE_PASS * POST_PROCESS_SCALE_EDGE_PASS))) {
+				m_scale_pass.assign(DISPLAY_WIDTH * DISPLAY_HEIGHT * POST_PROCESS_SCALE_EDGE_PASS
+					* POST_PROCESS_SCALE_EDGE_PASS, {});
+			}
+
+			refresh = true;
+		}
+
+		if(fresh && !halted) {
+
+			if(crt & DISPLAY_CRT_ENABLED) {
+				filter_crt(frame);
+			} else if(!headless()) {
+
+				// the unscaled frame is hashed, so a frame identical to the last one is neither scaled nor redrawn; the
+				// crt filter changes every frame, so its frames are never compared
+				hash = nescc::core::hash::frame(frame);
+				changed = (refresh || (hash != m_present_hash));
+				m_present_hash = hash;
+			}
+		}
+
+		if(m_present_scale > POST_PROCESS_SCALE_DEFAULT) {
+
+			if(fresh && !halted && changed) {
+				scale_frame(frame);
+			}
+
+			m_backend->present(m_scale_frame, halted, !fresh, changed, border);
+		} else {
+			m_backend->present(frame, halted, !fresh, changed, border);
+		}
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::process_bands(
+		__in int stage,
+		__in uint16_t height
+		)
+	{
+		uint16_t begin = 0, rows;
+		uint32_t band, count = (m_worker_count + 1);
+
+		TRACE_ENTRY_FORMAT("Stage=%i, Height=%u", stage, height);
+
+		m_band_stage = stage;
+
+		// rows are split into one band per worker, plus a band for the calling thread, which waits for the
+		// workers before returning
+		rows = ((height + (count - 1)) / count);
+
+		for(band = 1; band < count; ++band) {
+			begin = (band * rows);
+			m_worker[band - 1].dispatch(*this, band, begin, std::min<uint16_t>(begin + rows, height));
+		}
+
+		on_band(0, 0, std::min<uint16_t>(rows, height));
+
+		for(band = 1; band < count; ++band) {
+			m_worker[band - 1].synchronize();
+		}
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::queue_window(
+		__in int type,
+		__in_opt bool enabled,
+		__in_opt const std::string &value
+		)
+	{
+		TRACE_ENTRY_FORMAT("Type=%i, Enabled=%x, Value[%u]=%s", type, enabled, value.size(), STRING_CHECK(value));
+
+		{
+			std::lock_guard<std::mutex> lock(m_window_mutex);
+			m_window.push_back({ type, enabled, value, });
+		}
+
+		// without a presenter, the window operation is applied on the calling thread
+		if(headless()) {
+			update_window();
+		}
+
+		TRACE_EXIT();
+	}
+
 	uint32_t
 	display::read(
 		__in uint16_t x,
@@ -415,11 +743,7 @@ namespace nescc {
 #endif // NDEBUG
 
 		clear();
-		m_crt = crt;
-		m_crt_bleed = bleed;
-		m_crt_border = border;
-		m_crt_frame = 0;
-		m_crt_scanlines = scanlines;
+		m_crt = DISPLAY_CRT_SETTING(crt, bleed, scanlines, border);
 		m_debug = debug;
 		m_fullscreen = fullscreen;
 		m_halted = false;
@@ -427,6 +751,347 @@ namespace nescc {
 		TRACE_EXIT();
 	}
 
+	uint32_t
+	display::scale(void) const
+	{
+		uint32_t result;
+
+		TRACE_ENTRY();
+
+		result = DISPLAY_SCALE(m_scale);
+
+		TRACE_EXIT_FORMAT("Result=%u", result);
+		return result;
+	}
+
+	void
+	display::scale_band(
+		__in uint32_t index,
+		__in uint16_t begin,
+		__in uint16_t end
+		)
+	{
+		uint16_t pixel_y;
+		uint32_t pitch = (m_scale_width * m_scale_factor);
+
+		TRACE_ENTRY_FORMAT("Band[%u]=[%u, %u)", index, begin, end);
+
+		// rows past the frame's edges repeat its first and last rows
+		for(pixel_y = begin; pixel_y < end; ++pixel_y) {
+			const uint32_t *row = &m_scale_source[pixel_y * m_scale_width];
+			uint32_t *target = &m_scale_target[pixel_y * m_scale_factor * pitch];
+
+			if(m_present_scaler == POST_PROCESS_SCALER_EDGE) {
+				const uint32_t *row_down = ((pixel_y < (m_scale_height - 1)) ? (row + m_scale_width) : row),
+					*row_up = (pixel_y ? (row - m_scale_width) : row);
+
+				if(m_scale_factor == POST_PROCESS_SCALE_EDGE_PASS) {
+					scale_row_edge_2x(row_up, row, row_down, target);
+				} else {
+					scale_row_edge_3x(row_up, row, row_down, target);
+				}
+			} else {
+				scale_row_nearest(row, target);
+
+				for(uint32_t line = 1; line < m_scale_factor; ++line) {
+					std::memcpy(&target[line * pitch], target, pitch * sizeof(uint32_t));
+				}
+			}
+		}
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::scale_frame(
+		__in const std::vector<nescc::core::pixel_t> &frame
+		)
+	{
+		TRACE_ENTRY_FORMAT("Frame[%u]=%p", frame.size(), &frame[0]);
+
+		m_scale_height = DISPLAY_HEIGHT;
+		m_scale_source = &frame[0].raw;
+		m_scale_width = DISPLAY_WIDTH;
+
+		if(!m_scale_pass.empty()) {
+			m_scale_factor = POST_PROCESS_SCALE_EDGE_PASS;
+			m_scale_target = &m_scale_pass[0].raw;
+			process_bands(DISPLAY_BAND_SCALE, m_scale_height);
+			m_scale_height *= POST_PROCESS_SCALE_EDGE_PASS;
+			m_scale_source = &m_scale_pass[0].raw;
+			m_scale_width *= POST_PROCESS_SCALE_EDGE_PASS;
+		} else {
+			m_scale_factor = m_present_scale;
+		}
+
+		m_scale_target = &m_scale_frame[0].raw;
+		process_bands(DISPLAY_BAND_SCALE, m_scale_height);
+		m_scale_source = nullptr;
+		m_scale_target = nullptr;
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::scale_row_edge_2x(
+		__in const uint32_t *row_up,
+		__in const uint32_t *row,
+		__in const uint32_t *row_down,
+		__inout uint32_t *target
+		)
+	{
+		uint16_t pixel_x, pixel_x_simd = 1;
+		uint32_t pitch = (m_scale_width * POST_PROCESS_SCALE_EDGE_PASS);
+
+		TRACE_ENTRY_FORMAT("Row=%p, Target=%p", row, target);
+
+		// each pixel e, with neighbors b above, d left, f right and h below, becomes a 2x2 block whose corners take the
+		// color of the two neighbors meeting there when they match, unless the pixel sits on a straight line. The
+		// interior is vectorized, the first pixel and the tail, whose neighbors are clamped, are scaled one at a time
+#if POST_PROCESS_SIMD && defined(__AVX2__)
+		for(pixel_x = 1; (pixel_x + POST_PROCESS_SIMD_WIDTH_AVX2) < m_scale_width;
+				pixel_x += POST_PROCESS_SIMD_WIDTH_AVX2) {
+			__m256i b = _mm256_loadu_si256((const __m256i *) &row_up[pixel_x]),
+				d = _mm256_loadu_si256((const __m256i *) &row[pixel_x - 1]),
+				e = _mm256_loadu_si256((const __m256i *) &row[pixel_x]),
+				f = _mm256_loadu_si256((const __m256i *) &row[pixel_x + 1]),
+				h = _mm256_loadu_si256((const __m256i *) &row_down[pixel_x]),
+				straight = _mm256_or_si256(_mm256_cmpeq_epi32(b, h), _mm256_cmpeq_epi32(d, f));
+
+			POST_PROCESS_STORE_2_AVX2(&target[pixel_x * POST_PROCESS_SCALE_EDGE_PASS],
+				_mm256_blendv_epi8(e, d, _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(d, b))),
+				_mm256_blendv_epi8(e, f, _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(b, f))));
+			POST_PROCESS_STORE_2_AVX2(&target[pitch + (pixel_x * POST_PROCESS_SCALE_EDGE_PASS)],
+				_mm256_blendv_epi8(e, d, _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(d, h))),
+				_mm256_blendv_epi8(e, f, _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(h, f))));
+		}
+
+		pixel_x_simd = pixel_x;
+#elif POST_PROCESS_SIMD && defined(__SSE2__)
+		for(pixel_x = 1; (pixel_x + POST_PROCESS_SIMD_WIDTH_SSE2) < m_scale_width;
+				pixel_x += POST_PROCESS_SIMD_WIDTH_SSE2) {
+			__m128i b = _mm_loadu_si128((const __m128i *) &row_up[pixel_x]),
+				d = _mm_loadu_si128((const __m128i *) &row[pixel_x - 1]),
+				e = _mm_loadu_si128((const __m128i *) &row[pixel_x]),
+				f = _mm_loadu_si128((const __m128i *) &row[pixel_x + 1]),
+				h = _mm_loadu_si128((const __m128i *) &row_down[pixel_x]),
+				straight = _mm_or_si128(_mm_cmpeq_epi32(b, h), _mm_cmpeq_epi32(d, f));
+
+			POST_PROCESS_STORE_2_SSE2(&target[pixel_x * POST_PROCESS_SCALE_EDGE_PASS],
+				POST_PROCESS_SELECT_SSE2(_mm_andnot_si128(straight, _mm_cmpeq_epi32(d, b)), d, e),
+				POST_PROCESS_SELECT_SSE2(_mm_andnot_si128(straight, _mm_cmpeq_epi32(b, f)), f, e));
+			POST_PROCESS_STORE_2_SSE2(&target[pitch + (pixel_x * POST_PROCESS_SCALE_EDGE_PASS)],
+				POST_PROCESS_SELECT_SSE2(_mm_andnot_si128(straight, _mm_cmpeq_epi32(d, h)), d, e),
+				POST_PROCESS_SELECT_SSE2(_mm_andnot_si128(straight, _mm_cmpeq_epi32(h, f)), f, e));
+		}
+
+		pixel_x_simd = pixel_x;
+#endif // POST_PROCESS_SIMD
+
+		for(pixel_x = 0; pixel_x < m_scale_width; pixel_x = (pixel_x ? (pixel_x + 1) : pixel_x_simd)) {
+			uint32_t b = row_up[pixel_x], d = row[pixel_x ? (pixel_x - 1) : pixel_x], e = row[pixel_x],
+				f = row[(pixel_x < (m_scale_width - 1)) ? (pixel_x + 1) : pixel_x], h = row_down[pixel_x],
+				*block = &target[pixel_x * POST_PROCESS_SCALE_EDGE_PASS];
+			bool straight = ((b == h) || (d == f));
+
+			block[0] = ((!straight && (d == b)) ? d : e);
+			block[1] = ((!straight && (b == f)) ? f : e);
+			block[pitch] = ((!straight && (d == h)) ? d : e);
+			block[pitch + 1] = ((!straight && (h == f)) ? f : e);
+		}
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::scale_row_edge_3x(
+		__in const uint32_t *row_up,
+		__in const uint32_t *row,
+		__in const uint32_t *row_down,
+		__inout uint32_t *target
+		)
+	{
+		uint16_t pixel_x, pixel_x_simd = 1;
+		uint32_t pitch = (m_scale_width * (POST_PROCESS_SCALE_EDGE_PASS + 1));
+
+		TRACE_ENTRY_FORMAT("Row=%p, Target=%p", row, target);
+
+		// each pixel e, with neighbors a b c above, d f beside and g h i below, becomes a 3x3 block. Corners follow the
+		// 2x rule, while edge centers take the neighbor's color only where the matching corner rule holds and the pixel
+		// differs from the diagonal past that edge
+#if POST_PROCESS_SIMD && defined(__AVX2__)
+		for(pixel_x = 1; (pixel_x + POST_PROCESS_SIMD_WIDTH_AVX2) < m_scale_width;
+				pixel_x += POST_PROCESS_SIMD_WIDTH_AVX2) {
+			__m256i a = _mm256_loadu_si256((const __m256i *) &row_up[pixel_x - 1]),
+				b = _mm256_loadu_si256((const __m256i *) &row_up[pixel_x]),
+				c = _mm256_loadu_si256((const __m256i *) &row_up[pixel_x + 1]),
+				d = _mm256_loadu_si256((const __m256i *) &row[pixel_x - 1]),
+				e = _mm256_loadu_si256((const __m256i *) &row[pixel_x]),
+				f = _mm256_loadu_si256((const __m256i *) &row[pixel_x + 1]),
+				g = _mm256_loadu_si256((const __m256i *) &row_down[pixel_x - 1]),
+				h = _mm256_loadu_si256((const __m256i *) &row_down[pixel_x]),
+				i = _mm256_loadu_si256((const __m256i *) &row_down[pixel_x + 1]),
+				straight = _mm256_or_si256(_mm256_cmpeq_epi32(b, h), _mm256_cmpeq_epi32(d, f)),
+				bf = _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(b, f)),
+				db = _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(d, b)),
+				dh = _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(d, h)),
+				hf = _mm256_andnot_si256(straight, _mm256_cmpeq_epi32(h, f)),
+				ea = _mm256_cmpeq_epi32(e, a), ec = _mm256_cmpeq_epi32(e, c), eg = _mm256_cmpeq_epi32(e, g),
+				ei = _mm256_cmpeq_epi32(e, i);
+
+			POST_PROCESS_STORE_3_AVX2(&target[pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1)],
+				_mm256_blendv_epi8(e, d, db),
+				_mm256_blendv_epi8(e, b, _mm256_or_si256(_mm256_andnot_si256(ec, db), _mm256_andnot_si256(ea, bf))),
+				_mm256_blendv_epi8(e, f, bf));
+			POST_PROCESS_STORE_3_AVX2(&target[pitch + (pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1))],
+				_mm256_blendv_epi8(e, d, _mm256_or_si256(_mm256_andnot_si256(eg, db), _mm256_andnot_si256(ea, dh))),
+				e,
+				_mm256_blendv_epi8(e, f, _mm256_or_si256(_mm256_andnot_si256(ei, bf), _mm256_andnot_si256(ec, hf))));
+			POST_PROCESS_STORE_3_AVX2(&target[(pitch * 2) + (pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1))],
+				_mm256_blendv_epi8(e, d, dh),
+				_mm256_blendv_epi8(e, h, _mm256_or_si256(_mm256_andnot_si256(ei, dh), _mm256_andnot_si256(eg, hf))),
+				_mm256_blendv_epi8(e, f, hf));
+		}
+
+		pixel_x_simd = pixel_x;
+#elif POST_PROCESS_SIMD && defined(__SSE2__)
+		for(pixel_x = 1; (pixel_x + POST_PROCESS_SIMD_WIDTH_SSE2) < m_scale_width;
+				pixel_x += POST_PROCESS_SIMD_WIDTH_SSE2) {
+			__m128i a = _mm_loadu_si128((const __m128i *) &row_up[pixel_x - 1]),
+				b = _mm_loadu_si128((const __m128i *) &row_up[pixel_x]),
+				c = _mm_loadu_si128((const __m128i *) &row_up[pixel_x + 1]),
+				d = _mm_loadu_si128((const __m128i *) &row[pixel_x - 1]),
+				e = _mm_loadu_si128((const __m128i *) &row[pixel_x]),
+				f = _mm_loadu_si128((const __m128i *) &row[pixel_x + 1]),
+				g = _mm_loadu_si128((const __m128i *) &row_down[pixel_x - 1]),
+				h = _mm_loadu_si128((const __m128i *) &row_down[pixel_x]),
+				i = _mm_loadu_si128((const __m128i *) &row_down[pixel_x + 1]),
+				straight = _mm_or_si128(_mm_cmpeq_epi32(b, h), _mm_cmpeq_epi32(d, f)),
+				bf = _mm_andnot_si128(straight, _mm_cmpeq_epi32(b, f)),
+				db = _mm_andnot_si128(straight, _mm_cmpeq_epi32(d, b)),
+				dh = _mm_andnot_si128(straight, _mm_cmpeq_epi32(d, h)),
+				hf = _mm_andnot_si128(straight, _mm_cmpeq_epi32(h, f)),
+				ea = _mm_cmpeq_epi32(e, a), ec = _mm_cmpeq_epi32(e, c), eg = _mm_cmpeq_epi32(e, g),
+				ei = _mm_cmpeq_epi32(e, i);
+
+			POST_PROCESS_STORE_3_SSE2(&target[pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1)],
+				POST_PROCESS_SELECT_SSE2(db, d, e),
+				POST_PROCESS_SELECT_SSE2(_mm_or_si128(_mm_andnot_si128(ec, db), _mm_andnot_si128(ea, bf)), b, e),
+				POST_PROCESS_SELECT_SSE2(bf, f, e));
+			POST_PROCESS_STORE_3_SSE2(&target[pitch + (pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1))],
+				POST_PROCESS_SELECT_SSE2(_mm_or_si128(_mm_andnot_si128(eg, db), _mm_andnot_si128(ea, dh)), d, e),
+				e,
+				POST_PROCESS_SELECT_SSE2(_mm_or_si128(_mm_andnot_si128(ei, bf), _mm_andnot_si128(ec, hf)), f, e));
+			POST_PROCESS_STORE_3_SSE2(&target[(pitch * 2) + (pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1))],
+				POST_PROCESS_SELECT_SSE2(dh, d, e),
+				POST_PROCESS_SELECT_SSE2(_mm_or_si128(_mm_andnot_si128(ei, dh), _mm_andnot_si128(eg, hf)), h, e),
+				POST_PROCESS_SELECT_SSE2(hf, f, e));
+		}
+
+		pixel_x_simd = pixel_x;
+#endif // POST_PROCESS_SIMD
+
+		for(pixel_x = 0; pixel_x < m_scale_width; pixel_x = (pixel_x ? (pixel_x + 1) : pixel_x_simd)) {
+			uint16_t left = (pixel_x ? (pixel_x - 1) : pixel_x),
+				right = ((pixel_x < (m_scale_width - 1)) ? (pixel_x + 1) : pixel_x);
+			uint32_t a = row_up[left], b = row_up[pixel_x], c = row_up[right], d = row[left], e = row[pixel_x],
+				f = row[right], g = row_down[left], h = row_down[pixel_x], i = row_down[right],
+				*block = &target[pixel_x * (POST_PROCESS_SCALE_EDGE_PASS + 1)];
+			bool straight = ((b == h) || (d == f)), bf = (!straight && (b == f)), db = (!straight && (d == b)),
+				dh = (!straight && (d == h)), hf = (!straight && (h == f));
+
+			block[0] = (db ? d : e);
+			block[1] = (((db && (e != c)) || (bf && (e != a))) ? b : e);
+			block[2] = (bf ? f : e);
+			block[pitch] = (((db && (e != g)) || (dh && (e != a))) ? d : e);
+			block[pitch + 1] = e;
+			block[pitch + 2] = (((bf && (e != i)) || (hf && (e != c))) ? f : e);
+			block[pitch * 2] = (dh ? d : e);
+			block[(pitch * 2) + 1] = (((dh && (e != i)) || (hf && (e != g))) ? h : e);
+			block[(pitch * 2) + 2] = (hf ? f : e);
+		}
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::scale_row_nearest(
+		__in const uint32_t *row,
+		__inout uint32_t *target
+		)
+	{
+		uint16_t pixel_x;
+
+		TRACE_ENTRY_FORMAT("Row=%p, Target=%p", row, target);
+
+		// only the first output row is built, the band copies it down to the remaining rows of the block
+#if POST_PROCESS_SIMD && defined(__AVX2__)
+		for(pixel_x = 0; pixel_x < m_scale_width; pixel_x += POST_PROCESS_SIMD_WIDTH_AVX2) {
+			__m256i value = _mm256_loadu_si256((const __m256i *) &row[pixel_x]);
+			__m256i *block = (__m256i *) &target[pixel_x * m_scale_factor];
+
+			switch(m_scale_factor) {
+				case 2:
+					POST_PROCESS_STORE_2_AVX2(block, value, value);
+					break;
+				case 3:
+					POST_PROCESS_STORE_3_AVX2(block, value, value, value);
+					break;
+				default:
+
+					for(uint32_t part = 0; part < m_scale_factor; ++part) {
+						_mm256_storeu_si256(block + part, _mm256_permutevar8x32_epi32(value,
+							_mm256_setr_epi32(part * 2, part * 2, part * 2, part * 2, (part * 2) + 1, (part * 2) + 1,
+								(part * 2) + 1, (part * 2) + 1)));
+					}
+					break;
+			}
+		}
+#elif POST_PROCESS_SIMD && defined(__SSE2__)
+		for(pixel_x = 0; pixel_x < m_scale_width; pixel_x += POST_PROCESS_SIMD_WIDTH_SSE2) {
+			__m128i value = _mm_loadu_si128((const __m128i *) &row[pixel_x]);
+			__m128i *block = (__m128i *) &target[pixel_x * m_scale_factor];
+
+			switch(m_scale_factor) {
+				case 2:
+					POST_PROCESS_STORE_2_SSE2(block, value, value);
+					break;
+				case 3:
+					POST_PROCESS_STORE_3_SSE2(block, value, value, value);
+					break;
+				default:
+					_mm_storeu_si128(block, _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 0, 0, 0)));
+					_mm_storeu_si128(block + 1, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 1, 1, 1)));
+					_mm_storeu_si128(block + 2, _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 2, 2, 2)));
+					_mm_storeu_si128(block + 3, _mm_shuffle_epi32(value, _MM_SHUFFLE(3, 3, 3, 3)));
+					break;
+			}
+		}
+#else
+		for(pixel_x = 0; pixel_x < m_scale_width; ++pixel_x) {
+
+			for(uint32_t part = 0; part < m_scale_factor; ++part) {
+				target[(pixel_x * m_scale_factor) + part] = row[pixel_x];
+			}
+		}
+#endif // POST_PROCESS_SIMD
+
+		TRACE_EXIT();
+	}
+
+	int
+	display::scaler(void) const
+	{
+		int result;
+
+		TRACE_ENTRY();
+
+		result = DISPLAY_SCALER(m_scale);
+
+		TRACE_EXIT_FORMAT("Result=%i", result);
+		return result;
+	}
+
 	void
 	display::set_filter_crt(
 		__in bool crt,
@@ -435,8 +1100,6 @@ namespace nescc {
 		__in_opt bool border
 		)
 	{
-		bool change;
-
 		TRACE_ENTRY_FORMAT("CRT filter=%x, Bleed=%x, Scanlines=%x, Border=%x", crt, bleed, scanlines, border);
 
 #ifndef NDEBUG
@@ -445,22 +1108,7 @@ namespace nescc {
 		}
 #endif // NDEBUG
 
-		change = (crt != m_crt);
-		m_crt = crt;
-		m_crt_bleed = bleed;
-		m_crt_border = border;
-		m_crt_frame = 0;
-		m_crt_scanlines = scanlines;
-
-		if(change) {
-
-			if(m_window) {
-				destroy_texture();
-				create_texture();
-			}
-
-			m_pixel_previous.assign(m_pixel.begin(), m_pixel.end());
-		}
+		m_crt = DISPLAY_CRT_SETTING(crt, bleed, scanlines, border);
 
 		TRACE_EXIT();
 	}
@@ -482,7 +1130,7 @@ namespace nescc {
 
 		result << NESCC << " -- " << m_title << " (" << FLOAT_PRECISION(DISPLAY_FRAME_RATE_PRECISION, rate)
 			<< " FPS)";
-		SDL_SetWindowTitle(m_window, result.str().c_str());
+		queue_window(DISPLAY_WINDOW_TITLE, false, result.str());
 
 		TRACE_EXIT();
 	}
@@ -505,13 +1153,41 @@ namespace nescc {
 		TRACE_EXIT();
 	}
 
+	void
+	display::set_headless(
+		__in bool headless
+		)
+	{
+		nescc::interface::backend *backend;
+
+		TRACE_ENTRY_FORMAT("Headless=%x", headless);
+
+		backend = (headless ? static_cast<nescc::interface::backend *>(&m_backend_headless)
+				: static_cast<nescc::interface::backend *>(&m_backend_sdl));
+
+		if(backend != m_backend) {
+
+			if(m_initialized) {
+				destroy_backend();
+			}
+
+			m_backend = backend;
+
+			if(m_initialized) {
+				create_backend();
+				m_fullscreen = false;
+				m_shown = true;
+			}
+		}
+
+		TRACE_EXIT();
+	}
+
 	void
 	display::set_icon(
 		__in const std::string &path
 		)
 	{
-		SDL_Surface *surface;
-
 		TRACE_ENTRY_FORMAT("Path[%u]=%s", path.size(), STRING_CHECK(path));
 
 #ifndef NDEBUG
@@ -520,17 +1196,50 @@ namespace nescc {
 		}
 #endif // NDEBUG
 
-		surface = SDL_LoadBMP(path.c_str());
-		if(surface) {
-			SDL_SetWindowIcon(m_window, surface);
+		queue_window(DISPLAY_WINDOW_ICON, false, path);
 
-			if(surface) {
-				SDL_FreeSurface(surface);
-				surface = nullptr;
-			}
-		} else {
-			TRACE_MESSAGE_FORMAT(TRACE_WARNING, "SDL_LoadBMP failed!", "Error=%s", SDL_GetError());
+		TRACE_EXIT();
+	}
+
+	void
+	display::set_low_power(
+		__in bool low_power
+		)
+	{
+		TRACE_ENTRY_FORMAT("Low-power=%x", low_power);
+
+#ifndef NDEBUG
+		if(!m_initialized) {
+			THROW_NESCC_DISPLAY_EXCEPTION(NESCC_DISPLAY_EXCEPTION_UNINITIALIZED);
 		}
+#endif // NDEBUG
+
+		// only the flag is set here, the presenter hands it to the backend before its next present
+		m_low_power = low_power;
+
+		TRACE_EXIT();
+	}
+
+	void
+	display::set_scale(
+		__in uint32_t scale,
+		__in_opt int scaler
+		)
+	{
+		TRACE_ENTRY_FORMAT("Scale=%u, Scaler=%i", scale, scaler);
+
+#ifndef NDEBUG
+		if(!m_initialized) {
+			THROW_NESCC_DISPLAY_EXCEPTION(NESCC_DISPLAY_EXCEPTION_UNINITIALIZED);
+		}
+#endif // NDEBUG
+
+		if(!scale || (scale > POST_PROCESS_SCALE_MAX) || (scaler < 0) || (scaler > POST_PROCESS_SCALER_MAX)) {
+			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_SCALE, "Scale=%u, Scaler=%i", scale, scaler);
+		}
+
+		// only the fields are set here, the presenter resizes its buffers and the backend before its next present
+		m_scale = DISPLAY_SCALE_SETTING(scale, scaler);
 
 		TRACE_EXIT();
 	}
@@ -552,7 +1261,7 @@ namespace nescc {
 
 		m_title = title;
 		result << NESCC << " -- " << m_title;
-		SDL_SetWindowTitle(m_window, result.str().c_str());
+		queue_window(DISPLAY_WINDOW_TITLE, false, result.str());
 
 		TRACE_EXIT();
 	}
@@ -573,11 +1282,11 @@ namespace nescc {
 		if(shown != m_shown) {
 
 			m_shown = shown;
+			queue_window(DISPLAY_WINDOW_SHOW, m_shown);
+
 			if(m_shown) {
-				SDL_ShowWindow(m_window);
 				TRACE_DEBUG(m_debug, "Display shown");
 			} else {
-				SDL_HideWindow(m_window);
 				TRACE_DEBUG(m_debug, "Display hidden");
 			}
 		}
@@ -605,6 +1314,7 @@ namespace nescc {
 		__in_opt bool verbose
 		) const
 	{
+		uint32_t crt, scale;
 		std::stringstream result;
 
 		TRACE_ENTRY_FORMAT("Verbose=%x", verbose);
@@ -615,21 +1325,26 @@ namespace nescc {
 			result << " Base=" << nescc::core::singleton<nescc::display>::to_string(verbose);
 
 			if(m_initialized) {
+				crt = m_crt;
+				scale = m_scale;
 				result << ", Mode=" << (m_debug ? "Debug" : "Normal")
-					<< "CRT filter=" << (m_crt ? "Enabled" : "Disabled");
+					<< "CRT filter=" << ((crt & DISPLAY_CRT_ENABLED) ? "Enabled" : "Disabled");
 
-				if(m_crt) {
-					result << "(Bleed=" << (m_crt_bleed ? "Enabled" : "Disabled")
-						<< ", Border=" << (m_crt_border ? "Enabled" : "Disabled")
-						<< ", Scanlines=" << (m_crt_scanlines ? "Enabled" : "Disabled") << ")";
+				if(crt & DISPLAY_CRT_ENABLED) {
+					result << "(Bleed=" << ((crt & DISPLAY_CRT_BLEED) ? "Enabled" : "Disabled")
+						<< ", Border=" << ((crt & DISPLAY_CRT_BORDER) ? "Enabled" : "Disabled")
+						<< ", Scanlines=" << ((crt & DISPLAY_CRT_SCANLINES) ? "Enabled" : "Disabled") << ")";
 				}
 
-				result << ", Window=" << SCALAR_AS_HEX(uintptr_t, m_window)
+				result << ", Presenter=" << nescc::core::thread::to_string(verbose)
+					<< ", Low-power=" << (m_low_power ? "Enabled" : "Disabled")
+					<< ", Scale=" << DISPLAY_SCALE(scale) << "x("
+						<< ((DISPLAY_SCALER(scale) == POST_PROCESS_SCALER_EDGE) ? "Edge" : "Nearest") << ")"
+					<< ", Workers=" << m_worker_count
+					<< ", Backend=" << m_backend->to_string(verbose)
 						<< "(" << (m_shown ? "Shown" : "Hidden")
 							<< "/" << (m_fullscreen ? "Fullscreen" : "Window")
 							<< "/" << (m_halted ? "Halted" : "Running") << ")"
-					<< ", Renderer=" << SCALAR_AS_HEX(uintptr_t, m_renderer)
-					<< ", Texture=" << SCALAR_AS_HEX(uintptr_t, m_texture)
 					<< ", Title[" << m_title.size() << "]=" << STRING_CHECK(m_title)
 					<< ", Pixel[" << m_pixel.size() << "]=" << SCALAR_AS_HEX(uintptr_t, &m_pixel[0]);
 			}
@@ -642,8 +1357,6 @@ namespace nescc {
 	void
 	display::toggle_fullscreen(void)
 	{
-		int mode = (!m_fullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0);
-
 		TRACE_ENTRY();
 
 #ifndef NDEBUG
@@ -652,23 +1365,19 @@ namespace nescc {
 		}
 #endif // NDEBUG
 
-		if(SDL_SetWindowFullscreen(m_window, mode)) {
-			THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_SetWindowFullscreen failed! Error=%s", SDL_GetError());
-		}
-
 		m_fullscreen = !m_fullscreen;
-		SDL_ShowCursor(!m_fullscreen ? SDL_ENABLE : SDL_DISABLE);
+		queue_window(DISPLAY_WINDOW_FULLSCREEN, m_fullscreen);
 
 		TRACE_EXIT();
 	}
 
 	void
 	display::update(
-		__in_opt bool paused
+		__in_opt bool paused,
+		__in_opt bool complete
 		)
 	{
-		TRACE_ENTRY();
+		TRACE_ENTRY_FORMAT("Paused=%x, Complete=%x", paused, complete);
 
 #ifndef NDEBUG
 		if(!m_initialized) {
@@ -678,58 +1387,74 @@ namespace nescc {
 
 		if(m_shown) {
 
-			if(m_halted) {
+			if(headless()) {
+				present(m_pixel, !paused);
+			} else {
 
-				if(SDL_RenderClear(m_renderer)) {
-					THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-						"SDL_RenderClear failed! Error=%s", SDL_GetError());
+				if(nescc::core::thread::stopped()) {
+					THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_PRESENT, "%s",
+						STRING_CHECK(m_exception.to_string(true)));
 				}
 
-				if(m_texture_halt) {
-
-					if(SDL_RenderCopy(m_renderer, m_texture_halt, nullptr, nullptr)) {
-						THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-							"SDL_RenderCopy failed! Error=%s", SDL_GetError());
+				// the finished frame is handed to the presenter thread through a lock-free swap, so the emulation
+				// thread never waits on the renderer
+				if(!m_halted && !paused) {
+#if DISPLAY_FRAME_SWAP
+					// only a frame the ppu has completed is traded with the write slot instead of copied, since the ppu
+					// then redraws every pixel of the next rendered frame
+					if(complete) {
+						m_frame[m_frame_write].swap(m_pixel);
+					} else {
+						m_frame[m_frame_write].assign(m_pixel.begin(), m_pixel.end());
 					}
+#else
+					m_frame[m_frame_write].assign(m_pixel.begin(), m_pixel.end());
+#endif // DISPLAY_FRAME_SWAP
+					m_frame_write = (m_frame_ready.exchange(m_frame_write | DISPLAY_FRAME_FRESH) & DISPLAY_FRAME_INDEX);
 				}
-			} else if(!paused) {
 
-				if(m_crt) {
-					filter_crt();
-				}
+				nescc::core::thread::notify();
+			}
+		}
 
-				if(m_texture) {
+		TRACE_DEBUG(m_debug, "Display update");
 
-					if(SDL_UpdateTexture(m_texture, nullptr, &m_pixel[0], DISPLAY_WIDTH * sizeof(uint32_t))) {
-						THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-							"SDL_UpdateTexture failed! Error=%s", SDL_GetError());
-					}
+		TRACE_EXIT();
+	}
 
-					if(SDL_RenderClear(m_renderer)) {
-						THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-							"SDL_RenderClear failed! Error=%s", SDL_GetError());
-					}
+	void
+	display::update_window(void)
+	{
+		std::vector<display_window_t> window;
+		std::vector<display_window_t>::iterator iter;
 
-					if(SDL_RenderCopy(m_renderer, m_texture, nullptr, nullptr)) {
-						THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-							"SDL_RenderCopy failed! Error=%s", SDL_GetError());
-					}
-				}
+		TRACE_ENTRY();
 
-				if(m_crt && m_crt_border && m_texture_border) {
+		{
+			std::lock_guard<std::mutex> lock(m_window_mutex);
+			window.swap(m_window);
+		}
 
-					if(SDL_RenderCopy(m_renderer, m_texture_border, nullptr, nullptr)) {
-						THROW_NESCC_DISPLAY_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_EXTERNAL,
-							"SDL_RenderCopy failed! Error=%s", SDL_GetError());
-					}
-				}
+		for(iter = window.begin(); iter != window.end(); ++iter) {
+
+			switch(iter->type) {
+				case DISPLAY_WINDOW_FULLSCREEN:
+					m_backend->set_fullscreen(iter->enabled);
+					break;
+				case DISPLAY_WINDOW_ICON:
+					m_backend->set_icon(iter->value);
+					break;
+				case DISPLAY_WINDOW_SHOW:
+					m_backend->show(iter->enabled);
+					break;
+				case DISPLAY_WINDOW_TITLE:
+					m_backend->set_title(iter->value);
+					break;
+				default:
+					break;
 			}
-
-			SDL_RenderPresent(m_renderer);
 		}
 
-		TRACE_DEBUG(m_debug, "Display update");
-
 		TRACE_EXIT();
 	}
 
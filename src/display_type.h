@@ -19,6 +19,7 @@
 #ifndef NESCC_DISPLAY_TYPE_H_
 #define NESCC_DISPLAY_TYPE_H_
 
+#include <climits>
 #include "../include/exception.h"
 #include "../include/core/bitmap.h"
 
@@ -32,16 +33,18 @@ namespace nescc {
 #endif // NDEBUG
 
 	enum {
-		NESCC_DISPLAY_EXCEPTION_EXTERNAL = 0,
-		NESCC_DISPLAY_EXCEPTION_POSITION,
+		NESCC_DISPLAY_EXCEPTION_POSITION = 0,
+		NESCC_DISPLAY_EXCEPTION_PRESENT,
+		NESCC_DISPLAY_EXCEPTION_SCALE,
 		NESCC_DISPLAY_EXCEPTION_UNINITIALIZED,
 	};
 
 	#define NESCC_DISPLAY_EXCEPTION_MAX NESCC_DISPLAY_EXCEPTION_UNINITIALIZED
 
 	static const std::string NESCC_DISPLAY_EXCEPTION_STR[] = {
-		NESCC_DISPLAY_EXCEPTION_HEADER "External display exception",
 		NESCC_DISPLAY_EXCEPTION_HEADER "Invalid pixel position",
+		NESCC_DISPLAY_EXCEPTION_HEADER "Display presenter failed",
+		NESCC_DISPLAY_EXCEPTION_HEADER "Unsupported display scale",
 		NESCC_DISPLAY_EXCEPTION_HEADER "Display is uninitialized",
 		};
 
@@ -55,22 +58,115 @@ namespace nescc {
 		THROW_EXCEPTION_FORMAT(NESCC_DISPLAY_EXCEPTION_STRING(_EXCEPT_), \
 			_FORMAT_, __VA_ARGS__)
 
-	#define DISPLAY_FLAG (SDL_WINDOW_RESIZABLE)
-	#define DISPLAY_FLAG_RENDERER (SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC)
+	enum {
+		DISPLAY_BAND_CRT = 0,
+		DISPLAY_BAND_SCALE,
+	};
+
+	enum {
+		DISPLAY_WINDOW_FULLSCREEN = 0,
+		DISPLAY_WINDOW_ICON,
+		DISPLAY_WINDOW_SHOW,
+		DISPLAY_WINDOW_TITLE,
+	};
+
+	// the filter settings are kept in one word, so the presenter never sees a partial update
+	#define DISPLAY_CRT_BLEED 0x2
+	#define DISPLAY_CRT_BORDER 0x4
+	#define DISPLAY_CRT_ENABLED 0x1
+	#define DISPLAY_CRT_SCANLINES 0x8
+
+	#define DISPLAY_CRT_SETTING(_CRT_, _BLEED_, _SCANLINES_, _BORDER_) \
+		(((_CRT_) ? DISPLAY_CRT_ENABLED : 0) | ((_BLEED_) ? DISPLAY_CRT_BLEED : 0) \
+			| ((_SCANLINES_) ? DISPLAY_CRT_SCANLINES : 0) | ((_BORDER_) ? DISPLAY_CRT_BORDER : 0))
+
+	#define DISPLAY_FRAME_FRESH 0x4
+	#define DISPLAY_FRAME_INDEX 0x3
 	#define DISPLAY_FRAME_RATE_PRECISION 1
-	#define DISPLAY_HEIGHT 240
-	#define DISPLAY_QUALITY "0" // nearest
-	#define DISPLAY_QUALITY_CRT "1" // linear
-	#define DISPLAY_SCALE 2
-	#define DISPLAY_WIDTH 256
-	#define DISPLAY_WIDTH_STRETCH 320
+
+#ifndef DISPLAY_FRAME_SWAP
+	// the framebuffer is copied into the write slot by default, since a swap leaves an older frame behind in the
+	// framebuffer, which shows through partial frames (step mode, display reads) until the ppu redraws it
+	#define DISPLAY_FRAME_SWAP 0
+#endif // DISPLAY_FRAME_SWAP
+
+	// the scale and scaler are kept in one word, so the presenter never pairs a new scale with the old scaler
+	#define DISPLAY_SCALE(_SETTING_) ((_SETTING_) & UINT8_MAX)
+	#define DISPLAY_SCALE_SETTING(_SCALE_, _SCALER_) ((((uint32_t) (_SCALER_)) << CHAR_BIT) | (_SCALE_))
+	#define DISPLAY_SCALER(_SETTING_) ((int) ((_SETTING_) >> CHAR_BIT))
 
 	#define POST_PROCESS_BLEED 1
-	#define POST_PROCESS_BLEED_RATIO 0.6
-	#define POST_PROCESS_BLEED_SWEEP_RATIO 0.75
-	#define POST_PROCESS_BORDER_PATH "./asset/border.bmp"
-	#define POST_PROCESS_HALT_PATH "./asset/halt.bmp"
-	#define POST_PROCESS_SCANLINE_ARTIFACT_RATIO 0.9
+	#define POST_PROCESS_BLEED_RATIO 0.6 // of the frame, the rest of the previous frame
+	#define POST_PROCESS_BLEED_SWEEP_SHIFT 2
+	#define POST_PROCESS_BLEED_SWEEP_WEIGHT 3 // 0.75 of the pixel, 0.25 of its neighbor, exact in integers
+	#define POST_PROCESS_BLEND_INDEX(_LEFT_, _RIGHT_) (((_LEFT_) << CHAR_BIT) | (_RIGHT_))
+	#define POST_PROCESS_BLEND_LENGTH (1 << (CHAR_BIT * 2)) // every pair of channel values
+	#define POST_PROCESS_BLEND_PADDING sizeof(uint32_t) // a gather reads four bytes at the last index
+	#define POST_PROCESS_CHANNEL_MAX 3 // blue, green, red
+	#define POST_PROCESS_MASK_ALPHA 0xff000000
+	#define POST_PROCESS_MASK_GREEN_BLUE 0x0000ffff
+	#define POST_PROCESS_MASK_RED 0x00ff0000
+	#define POST_PROCESS_SCANLINE_ARTIFACT_RATIO 0.9 // of the pixel, the rest of the artifact
+
+#ifndef POST_PROCESS_SIMD
+	#define POST_PROCESS_SIMD 1
+#endif // POST_PROCESS_SIMD
+
+	#define POST_PROCESS_SIMD_WIDTH_AVX2 8 // pixels
+	#define POST_PROCESS_SIMD_WIDTH_SSE2 4
+
+	// looks up one channel of eight pixels in a blend table, which yields the blended channel in each 32-bit lane
+	#define POST_PROCESS_BLEND_AVX2(_TABLE_, _LEFT_, _RIGHT_, _SHIFT_, _MASK_) \
+		_mm256_and_si256(_mm256_i32gather_epi32((const int *) (_TABLE_), _mm256_or_si256(_mm256_slli_epi32( \
+			_mm256_and_si256(_mm256_srli_epi32(_LEFT_, _SHIFT_), _MASK_), CHAR_BIT), \
+			_mm256_and_si256(_mm256_srli_epi32(_RIGHT_, _SHIFT_), _MASK_)), 1), _MASK_)
+
+	#define POST_PROCESS_SCALE_EDGE_PASS 2 // the edge scaler reaches 4x through two 2x passes
+
+	#define POST_PROCESS_SELECT_SSE2(_MASK_, _VALUE_, _DEFAULT_) \
+		_mm_or_si128(_mm_and_si128(_MASK_, _VALUE_), _mm_andnot_si128(_MASK_, _DEFAULT_))
+
+	// stores pixels a0 b0 a1 b1 ...
+	#define POST_PROCESS_STORE_2_AVX2(_TARGET_, _FIRST_, _SECOND_) { \
+		__m256i _high_ = _mm256_unpackhi_epi32(_FIRST_, _SECOND_), _low_ = _mm256_unpacklo_epi32(_FIRST_, _SECOND_); \
+		_mm256_storeu_si256((__m256i *) (_TARGET_), _mm256_permute2x128_si256(_low_, _high_, 0x20)); \
+		_mm256_storeu_si256(((__m256i *) (_TARGET_)) + 1, _mm256_permute2x128_si256(_low_, _high_, 0x31)); \
+		}
+	#define POST_PROCESS_STORE_2_SSE2(_TARGET_, _FIRST_, _SECOND_) { \
+		_mm_storeu_si128((__m128i *) (_TARGET_), _mm_unpacklo_epi32(_FIRST_, _SECOND_)); \
+		_mm_storeu_si128(((__m128i *) (_TARGET_)) + 1, _mm_unpackhi_epi32(_FIRST_, _SECOND_)); \
+		}
+
+	// stores pixels a0 b0 c0 a1 b1 c1 ..., each output vector gathers its pixels from all three inputs, then takes
+	// every third lane from each
+	#define POST_PROCESS_STORE_3_AVX2(_TARGET_, _FIRST_, _SECOND_, _THIRD_) { \
+		__m256i _index_[] = { _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2), _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5), \
+			_mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7), }; \
+		_mm256_storeu_si256((__m256i *) (_TARGET_), _mm256_blend_epi32(_mm256_blend_epi32( \
+			_mm256_permutevar8x32_epi32(_FIRST_, _index_[0]), _mm256_permutevar8x32_epi32(_SECOND_, _index_[0]), 0x92), \
+			_mm256_permutevar8x32_epi32(_THIRD_, _index_[0]), 0x24)); \
+		_mm256_storeu_si256(((__m256i *) (_TARGET_)) + 1, _mm256_blend_epi32(_mm256_blend_epi32( \
+			_mm256_permutevar8x32_epi32(_FIRST_, _index_[1]), _mm256_permutevar8x32_epi32(_SECOND_, _index_[1]), 0x24), \
+			_mm256_permutevar8x32_epi32(_THIRD_, _index_[1]), 0x49)); \
+		_mm256_storeu_si256(((__m256i *) (_TARGET_)) + 2, _mm256_blend_epi32(_mm256_blend_epi32( \
+			_mm256_permutevar8x32_epi32(_FIRST_, _index_[2]), _mm256_permutevar8x32_epi32(_SECOND_, _index_[2]), 0x49), \
+			_mm256_permutevar8x32_epi32(_THIRD_, _index_[2]), 0x92)); \
+		}
+	#define POST_PROCESS_STORE_3_SSE2(_TARGET_, _FIRST_, _SECOND_, _THIRD_) { \
+		__m128i _mask_[] = { _mm_setr_epi32(-1, 0, 0, -1), _mm_setr_epi32(0, -1, 0, 0), _mm_setr_epi32(0, 0, -1, 0), }; \
+		_mm_storeu_si128((__m128i *) (_TARGET_), _mm_or_si128(_mm_or_si128( \
+			_mm_and_si128(_mm_shuffle_epi32(_FIRST_, _MM_SHUFFLE(1, 0, 0, 0)), _mask_[0]), \
+			_mm_and_si128(_mm_shuffle_epi32(_SECOND_, _MM_SHUFFLE(1, 0, 0, 0)), _mask_[1])), \
+			_mm_and_si128(_mm_shuffle_epi32(_THIRD_, _MM_SHUFFLE(1, 0, 0, 0)), _mask_[2]))); \
+		_mm_storeu_si128(((__m128i *) (_TARGET_)) + 1, _mm_or_si128(_mm_or_si128( \
+			_mm_and_si128(_mm_shuffle_epi32(_FIRST_, _MM_SHUFFLE(2, 2, 1, 1)), _mask_[2]), \
+			_mm_and_si128(_mm_shuffle_epi32(_SECOND_, _MM_SHUFFLE(2, 2, 1, 1)), _mask_[0])), \
+			_mm_and_si128(_mm_shuffle_epi32(_THIRD_, _MM_SHUFFLE(2, 2, 1, 1)), _mask_[1]))); \
+		_mm_storeu_si128(((__m128i *) (_TARGET_)) + 2, _mm_or_si128(_mm_or_si128( \
+			_mm_and_si128(_mm_shuffle_epi32(_FIRST_, _MM_SHUFFLE(3, 3, 3, 2)), _mask_[1]), \
+			_mm_and_si128(_mm_shuffle_epi32(_SECOND_, _MM_SHUFFLE(3, 3, 3, 2)), _mask_[2])), \
+			_mm_and_si128(_mm_shuffle_epi32(_THIRD_, _MM_SHUFFLE(3, 3, 3, 2)), _mask_[0]))); \
+		}
 
 	static const std::vector<nescc::core::pixel_t> POST_PROCESS_SIGNAL_ART = {
 		{ .red = UINT8_MAX, },
@@ -89,9 +185,6 @@ namespace nescc {
 	#define POST_PROCESS_SIGNAL_ARTIFACT(_X_, _Y_, _OFFSET_) \
 		POST_PROCESS_SIGNAL_ART.at(((((_Y_) + (_OFFSET_)) % POST_PROCESS_SIGNAL_ARTIFACT_WIDTH) \
 			* POST_PROCESS_SIGNAL_ARTIFACT_WIDTH) + (_X_ % POST_PROCESS_SIGNAL_ARTIFACT_WIDTH))
-
-	#define PIXEL_BLEND(_LEFT_, _RIGHT_, _RATIO_) \
-		(((_RATIO_) * (_LEFT_)) + ((1.0 - (_RATIO_)) * (_RIGHT_)))
 }
 
 #endif // NESCC_DISPLAY_TYPE_H_
@@ -16,8 +16,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstring>
 #include "../../include/emulator/apu.h"
+#include "../../include/emulator/bus.h"
 #include "../../include/trace.h"
 #include "./apu_type.h"
 
@@ -50,6 +52,8 @@ namespace nescc {
 		apu::apu(void) :
 			m_cycle(0),
 			m_debug(false),
+			m_event_frame(event_distance(0, APU_UPDATE_FRAME_RATE)),
+			m_event_sample(event_distance(0, APU_UPDATE_SAMPLE_RATE)),
 			m_format({ }),
 			m_frame_step(0),
 			m_odd(true),
@@ -286,6 +290,8 @@ namespace nescc {
 			m_triangle_timer_high.raw = 0;
 			m_cycle = 0;
 			m_debug = false;
+			m_event_frame = event_distance(m_cycle, APU_UPDATE_FRAME_RATE);
+			m_event_sample = event_distance(m_cycle, APU_UPDATE_SAMPLE_RATE);
 			m_frame_step = 0;
 			m_odd = true;
 			m_paused = false;
@@ -310,6 +316,38 @@ namespace nescc {
 			return m_cycle;
 		}
 
+		uint32_t
+		apu::event_distance(
+			__in uint32_t cycle,
+			__in float rate
+			)
+		{
+			uint64_t next;
+			uint32_t result, value;
+
+			TRACE_ENTRY_FORMAT("Cycle=%u, Rate=%f", cycle, rate);
+
+			// find the first cycle at which the value, truncated from the same float division the event has always
+			// been derived from, changes (or the counter wraps)
+			value = APU_UPDATE_VALUE(cycle, rate);
+			next = std::max((uint64_t) ((value + 1) * (double) rate), (uint64_t) cycle + 1);
+			next = std::min(next, (uint64_t) UINT32_MAX + 1);
+
+			while((next > ((uint64_t) cycle + 1)) && (next <= UINT32_MAX)
+					&& (APU_UPDATE_VALUE((uint32_t) (next - 1), rate) != value)) {
+				--next;
+			}
+
+			while((next <= UINT32_MAX) && (APU_UPDATE_VALUE((uint32_t) next, rate) == value)) {
+				++next;
+			}
+
+			result = (next - cycle);
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
 		bool
 		apu::on_initialize(void)
 		{
@@ -437,7 +475,7 @@ namespace nescc {
 
 		void
 		apu::reset(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in_opt bool debug
 			)
 		{
@@ -468,6 +506,8 @@ namespace nescc {
 			m_triangle_timer_high.raw = 0;
 			m_cycle = 0;
 			m_debug = debug;
+			m_event_frame = event_distance(m_cycle, APU_UPDATE_FRAME_RATE);
+			m_event_sample = event_distance(m_cycle, APU_UPDATE_SAMPLE_RATE);
 			m_frame_step = 0;
 			m_odd = true;
 			m_paused = false;
@@ -477,6 +517,27 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		uint32_t
+		apu::schedule_limit(void) const
+		{
+			uint32_t result;
+
+			TRACE_ENTRY();
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_APU_EXCEPTION(NESCC_EMULATOR_APU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			// the frame sequencer is the only part of the apu that can raise an interrupt, so the apu can be run
+			// forward by any number of cycles short of its next step in one update
+			result = (m_event_frame - 1);
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
 		std::string
 		apu::to_string(
 			__in_opt bool verbose
@@ -562,12 +623,11 @@ namespace nescc {
 
 		void
 		apu::update(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus,
+			__in uint32_t cycles
 			)
 		{
-			uint32_t frame, frame_previous, sample, sample_previous;
-
-			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+			TRACE_ENTRY_FORMAT("Bus=%p, Cycles=%u", &bus, cycles);
 
 #ifndef NDEBUG
 			if(!m_initialized) {
@@ -575,21 +635,27 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			TRACE_DEBUG_FORMAT(m_debug, "Apu update", "%s", m_odd ? "Odd" : "Even");
+			TRACE_DEBUG_FORMAT(m_debug, "Apu update", "%s, Cycles=%u", m_odd ? "Odd" : "Even", cycles);
 
-			update_timer();
-			frame_previous = (m_cycle / (float) APU_UPDATE_FRAME_RATE);
-			sample_previous = (m_cycle / (float) APU_UPDATE_SAMPLE_RATE);
-			++m_cycle;
-			frame = (m_cycle / (float) APU_UPDATE_FRAME_RATE);
-			sample = (m_cycle / (float) APU_UPDATE_SAMPLE_RATE);
+			update_timer(cycles);
 
-			if(frame != frame_previous) {
-				update_frame(bus);
-			}
+			while(cycles) {
+				uint32_t step = std::min(cycles, std::min(m_event_frame, m_event_sample));
+
+				m_cycle += step;
+				m_event_frame -= step;
+				m_event_sample -= step;
+				cycles -= step;
+
+				if(!m_event_frame) {
+					update_frame(bus);
+					m_event_frame = event_distance(m_cycle, APU_UPDATE_FRAME_RATE);
+				}
 
-			if(sample != sample_previous) {
-				update_sample();
+				if(!m_event_sample) {
+					update_sample();
+					m_event_sample = event_distance(m_cycle, APU_UPDATE_SAMPLE_RATE);
+				}
 			}
 
 			TRACE_DEBUG_FORMAT(m_debug, "Apu state", "\n%s", STRING_CHECK(as_string(true)));
@@ -599,7 +665,7 @@ namespace nescc {
 
 		void
 		apu::update_frame(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
@@ -775,27 +841,38 @@ namespace nescc {
 		}
 
 		void
-		apu::update_timer(void)
+		apu::update_timer(
+			__in uint32_t cycles
+			)
 		{
-			TRACE_ENTRY();
+			uint32_t ticks;
+
+			TRACE_ENTRY_FORMAT("Cycles=%u", cycles);
 
-			if(m_odd) {
-				update_timer_pulse(APU_PULSE_1);
-				update_timer_pulse(APU_PULSE_2);
-				update_timer_noise();
-				update_timer_dmc();
+			// pulse, noise and dmc timers are clocked on odd cycles, the triangle timer on every cycle
+			ticks = ((cycles + (m_odd ? 1 : 0)) / 2);
+			if(ticks) {
+				update_timer_pulse(APU_PULSE_1, ticks);
+				update_timer_pulse(APU_PULSE_2, ticks);
+				update_timer_noise(ticks);
+				update_timer_dmc(ticks);
 			}
 
-			update_timer_triangle();
-			m_odd = !m_odd;
+			update_timer_triangle(cycles);
+
+			if(cycles & 1) {
+				m_odd = !m_odd;
+			}
 
 			TRACE_EXIT();
 		}
 
 		void
-		apu::update_timer_dmc(void)
+		apu::update_timer_dmc(
+			__in uint32_t ticks
+			)
 		{
-			TRACE_ENTRY();
+			TRACE_ENTRY_FORMAT("Ticks=%u", ticks);
 
 			// TODO
 
@@ -803,9 +880,11 @@ namespace nescc {
 		}
 
 		void
-		apu::update_timer_noise(void)
+		apu::update_timer_noise(
+			__in uint32_t ticks
+			)
 		{
-			TRACE_ENTRY();
+			TRACE_ENTRY_FORMAT("Ticks=%u", ticks);
 
 			// TODO
 
@@ -814,10 +893,11 @@ namespace nescc {
 
 		void
 		apu::update_timer_pulse(
-			__in int channel
+			__in int channel,
+			__in uint32_t ticks
 			)
 		{
-			TRACE_ENTRY_FORMAT("Channel=%i", channel);
+			TRACE_ENTRY_FORMAT("Channel=%i, Ticks=%u", channel, ticks);
 
 			// TODO
 
@@ -825,9 +905,11 @@ namespace nescc {
 		}
 
 		void
-		apu::update_timer_triangle(void)
+		apu::update_timer_triangle(
+			__in uint32_t ticks
+			)
 		{
-			TRACE_ENTRY();
+			TRACE_ENTRY_FORMAT("Ticks=%u", ticks);
 
 			// TODO
 
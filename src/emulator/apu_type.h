@@ -64,6 +64,7 @@ namespace nescc {
 		#define APU_SAMPLE_RATE 16000
 		#define APU_UPDATE_FRAME_RATE (CLOCK_RATE / 240.f)
 		#define APU_UPDATE_SAMPLE_RATE (CLOCK_RATE / (float) APU_SAMPLE_RATE)
+		#define APU_UPDATE_VALUE(_CYCLE_, _RATE_) ((uint32_t) ((_CYCLE_) / (float) (_RATE_)))
 
 		enum {
 			APU_PORT_PULSE_1_TIMER = 0, // 0x4000 - 0x4003
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include "../../include/emulator/bus.h"
 #include "../../include/trace.h"
 #include "./bus_type.h"
@@ -31,6 +32,8 @@ namespace nescc {
 			m_display(nescc::display::acquire()),
 			m_joypad(nescc::emulator::joypad::acquire()),
 			m_mmu(nescc::emulator::mmu::acquire()),
+			m_page_read(),
+			m_page_write(),
 			m_ppu(nescc::emulator::ppu::acquire())
 		{
 			TRACE_ENTRY();
@@ -170,7 +173,7 @@ namespace nescc {
 			__in uint16_t address
 			)
 		{
-			uint8_t result = 0;
+			uint8_t *page, result = 0;
 
 			TRACE_ENTRY_FORMAT("Address=%u(%04x)", address, address);
 
@@ -180,41 +183,49 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			switch(address) {
-				case CPU_RAM_START ... CPU_RAM_END: // 0x0000 - 0x1fff
-					result = m_cpu.ram().read((address - CPU_RAM_START) % CPU_RAM_LENGTH);
-					break;
-				case PPU_PORT_START ... PPU_PORT_END: { // 0x2000 - 0x3fff
-
-						uint8_t port = ((address - PPU_PORT_START) % (PPU_PORT_MAX + 1));
-						switch(port) {
-							case PPU_PORT_STATUS: // 0x2002
-							case PPU_PORT_OAM_DATA: // 0x2004
-							case PPU_PORT_DATA: // 0x2007
-								result = m_ppu.read_port(*this, port);
-								break;
-							default:
-								TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region",
-									"Address=%u(%04x), Port=%u(%02x)", address, address,
-									port, port);
-								break;
-						}
-					} break;
-				case APU_CHANNEL_STATUS: // 0x4015
-					result = m_apu.read_port(address - APU_PULSE_1_START);
-					break;
-				case JOYPAD_PORT_1 ... JOYPAD_PORT_2: // 0x4016 - 0x4017
-					result = m_joypad.read_port(address - JOYPAD_PORT_1);
-					break;
-				case CARTRIDGE_RAM_PROGRAM_START ... CARTRIDGE_RAM_PROGRAM_END: // 0x6000 - 0x7fff
-					result = m_mmu.read_ram(address - CARTRIDGE_RAM_PROGRAM_START);
-					break;
-				case CARTRIDGE_ROM_PROGRAM_START ... CARTRIDGE_ROM_PROGRAM_END: // 0x8000 - 0xffff
-					result = m_mmu.read_rom_program(address - CARTRIDGE_ROM_PROGRAM_START);
-					break;
-				default:
-					TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region", "Address=%u(%04x)", address, address);
-					break;
+			page = m_page_read[address >> BUS_PAGE_SHIFT];
+			if(page) {
+				result = page[address & BUS_PAGE_MASK];
+			} else {
+				switch(address) {
+					case CPU_RAM_START ... CPU_RAM_END: // 0x0000 - 0x1fff
+						result = m_cpu.ram().read((address - CPU_RAM_START) % CPU_RAM_LENGTH);
+						break;
+					case PPU_PORT_START ... PPU_PORT_END: { // 0x2000 - 0x3fff
+
+							uint8_t port = ((address - PPU_PORT_START) % (PPU_PORT_MAX + 1));
+
+							m_ppu.synchronize(*this);
+
+							switch(port) {
+								case PPU_PORT_STATUS: // 0x2002
+								case PPU_PORT_OAM_DATA: // 0x2004
+								case PPU_PORT_DATA: // 0x2007
+									result = m_ppu.read_port(*this, port);
+									break;
+								default:
+									TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region",
+										"Address=%u(%04x), Port=%u(%02x)", address, address,
+										port, port);
+									break;
+							}
+						} break;
+					case APU_CHANNEL_STATUS: // 0x4015
+						result = m_apu.read_port(address - APU_PULSE_1_START);
+						break;
+					case JOYPAD_PORT_1 ... JOYPAD_PORT_2: // 0x4016 - 0x4017
+						result = m_joypad.read_port(address - JOYPAD_PORT_1);
+						break;
+					case CARTRIDGE_RAM_PROGRAM_START ... CARTRIDGE_RAM_PROGRAM_END: // 0x6000 - 0x7fff
+						result = m_mmu.read_ram(address - CARTRIDGE_RAM_PROGRAM_START);
+						break;
+					case CARTRIDGE_ROM_PROGRAM_START ... CARTRIDGE_ROM_PROGRAM_END: // 0x8000 - 0xffff
+						result = m_mmu.read_rom_program(address - CARTRIDGE_ROM_PROGRAM_START);
+						break;
+					default:
+						TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region", "Address=%u(%04x)", address, address);
+						break;
+				}
 			}
 
 			TRACE_DEBUG_FORMAT(m_debug, "Cpu bus read", "[%04x] -> %u(%02x)", address, result, result);
@@ -280,6 +291,8 @@ namespace nescc {
 			__in uint8_t value
 			)
 		{
+			uint8_t *page;
+
 			TRACE_ENTRY_FORMAT("Address=%u(%04x), Value=%u(%02x)", address, address, value, value);
 
 #ifndef NDEBUG
@@ -288,51 +301,66 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			switch(address) {
-				case CPU_RAM_START ... CPU_RAM_END: // 0x0000 - 0x1fff
-					m_cpu.ram().write((address - CPU_RAM_START) % CPU_RAM_LENGTH, value);
-					break;
-				case PPU_PORT_START ... PPU_PORT_END: { // 0x2000 - 0x3fff
-
-						uint8_t port = ((address - PPU_PORT_START) % (PPU_PORT_MAX + 1));
-						switch(port) {
-							case PPU_PORT_CONTROL: // 0x2000
-							case PPU_PORT_MASK: // 0x2001
-							case PPU_PORT_OAM_ADDRESS: // 0x2003
-							case PPU_PORT_OAM_DATA: // 0x2004
-							case PPU_PORT_SCROLL: // 0x2005
-							case PPU_PORT_ADDRESS: // 0x2006
-							case PPU_PORT_DATA: // 0x2007
-								m_ppu.write_port(*this, port, value);
-								break;
-							default:
-								TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region",
-									"Address=%u(%04x), Port=%u(%02x)", address, address,
-									port, port);
-								break;
+			page = m_page_write[address >> BUS_PAGE_SHIFT];
+			if(page) {
+				page[address & BUS_PAGE_MASK] = value;
+			} else {
+				switch(address) {
+					case CPU_RAM_START ... CPU_RAM_END: // 0x0000 - 0x1fff
+						m_cpu.ram().write((address - CPU_RAM_START) % CPU_RAM_LENGTH, value);
+						break;
+					case PPU_PORT_START ... PPU_PORT_END: { // 0x2000 - 0x3fff
+
+							uint8_t port = ((address - PPU_PORT_START) % (PPU_PORT_MAX + 1));
+
+							m_ppu.synchronize(*this);
+
+							switch(port) {
+								case PPU_PORT_CONTROL: // 0x2000
+								case PPU_PORT_MASK: // 0x2001
+								case PPU_PORT_OAM_ADDRESS: // 0x2003
+								case PPU_PORT_OAM_DATA: // 0x2004
+								case PPU_PORT_SCROLL: // 0x2005
+								case PPU_PORT_ADDRESS: // 0x2006
+								case PPU_PORT_DATA: // 0x2007
+									m_ppu.write_port(*this, port, value);
+									break;
+								default:
+									TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region",
+										"Address=%u(%04x), Port=%u(%02x)", address, address,
+										port, port);
+									break;
+							}
+						} break;
+					case APU_PULSE_1_START ... APU_DMC_END: // 0x4000 - 0x4013
+					case APU_CHANNEL_STATUS: // 0x4015
+					case APU_FRAME_COUNTER: // 0x4017
+						m_apu.write_port(address - APU_PULSE_1_START, value);
+						break;
+					case CPU_OAM_DMA: // 0x4014
+						m_ppu.synchronize(*this);
+						m_cpu.write_oam_dma(*this, value);
+						break;
+					case JOYPAD_PORT_1: // 0x4016
+						m_joypad.write_port(value);
+						break;
+					case CARTRIDGE_RAM_PROGRAM_START ... CARTRIDGE_RAM_PROGRAM_END: // 0x6000 - 0x7fff
+						m_mmu.write_ram(address - CARTRIDGE_RAM_PROGRAM_START, value);
+						break;
+					case CARTRIDGE_ROM_PROGRAM_START ... CARTRIDGE_ROM_PROGRAM_END: // 0x8000 - 0xffff
+						m_ppu.synchronize(*this);
+
+						// the page table and decoded instructions only go stale when the mapper reports a change
+						if(m_mmu.write_rom_program(*this, address - CARTRIDGE_ROM_PROGRAM_START, value)) {
+							m_cpu.invalidate_instructions();
+							map_pages();
 						}
-					} break;
-				case APU_PULSE_1_START ... APU_DMC_END: // 0x4000 - 0x4013
-				case APU_CHANNEL_STATUS: // 0x4015
-				case APU_FRAME_COUNTER: // 0x4017
-					m_apu.write_port(address - APU_PULSE_1_START, value);
-					break;
-				case CPU_OAM_DMA: // 0x4014
-					m_cpu.write_oam_dma(*this, value);
-					break;
-				case JOYPAD_PORT_1: // 0x4016
-					m_joypad.write_port(value);
-					break;
-				case CARTRIDGE_RAM_PROGRAM_START ... CARTRIDGE_RAM_PROGRAM_END: // 0x6000 - 0x7fff
-					m_mmu.write_ram(address - CARTRIDGE_RAM_PROGRAM_START, value);
-					break;
-				case CARTRIDGE_ROM_PROGRAM_START ... CARTRIDGE_ROM_PROGRAM_END: // 0x8000 - 0xffff
-					m_mmu.write_rom_program(*this, address - CARTRIDGE_ROM_PROGRAM_START, value);
-					break;
-				default:
-					TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region", "Address=%u(%04x), Value=%u(%02x)",
-						address, address, value, value);
-					break;
+						break;
+					default:
+						TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Unmapped cpu region", "Address=%u(%04x), Value=%u(%02x)",
+							address, address, value, value);
+						break;
+				}
 			}
 
 			if(m_watch_cpu.find(address) != m_watch_cpu.end()) {
@@ -362,6 +390,27 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		uint32_t *
+		bus::display_line(
+			__in uint16_t y
+			)
+		{
+			uint32_t *result;
+
+			TRACE_ENTRY_FORMAT("Line=%u", y);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_BUS_EXCEPTION(NESCC_EMULATOR_BUS_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			result = m_display.line(y);
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
 		void
 		bus::display_update(void)
 		{
@@ -373,7 +422,8 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			m_display.update();
+			// only the ppu's end-of-frame update hands off a complete frame
+			m_display.update(false, true);
 
 			TRACE_EXIT();
 		}
@@ -427,12 +477,51 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
+			unmap_pages();
 			m_mmu.cartridge().load(path);
 			m_mmu.reset(debug);
 
 			TRACE_EXIT();
 		}
 
+		void
+		bus::map_pages(void)
+		{
+			uint32_t address;
+
+			TRACE_ENTRY();
+
+			unmap_pages();
+
+			for(address = CPU_RAM_START; address <= CPU_RAM_END; address += BUS_PAGE_LENGTH) {
+				uint8_t *page = (m_cpu.ram().raw() + ((address - CPU_RAM_START) % CPU_RAM_LENGTH));
+
+				m_page_read[address >> BUS_PAGE_SHIFT] = page;
+				m_page_write[address >> BUS_PAGE_SHIFT] = page;
+			}
+
+			for(address = CARTRIDGE_RAM_PROGRAM_START; address <= CARTRIDGE_RAM_PROGRAM_END; address += BUS_PAGE_LENGTH) {
+				uint8_t *page = m_mmu.page_ram(address - CARTRIDGE_RAM_PROGRAM_START, BUS_PAGE_LENGTH);
+
+				m_page_read[address >> BUS_PAGE_SHIFT] = page;
+				m_page_write[address >> BUS_PAGE_SHIFT] = page;
+			}
+
+			// program rom pages are read-only, writes must still reach the mapper registers
+			for(address = CARTRIDGE_ROM_PROGRAM_START; address <= CARTRIDGE_ROM_PROGRAM_END; address += BUS_PAGE_LENGTH) {
+				m_page_read[address >> BUS_PAGE_SHIFT] = m_mmu.page_rom_program(address - CARTRIDGE_ROM_PROGRAM_START,
+					BUS_PAGE_LENGTH);
+			}
+
+			for(address = CARTRIDGE_ROM_CHARACTER_0_START; address <= CARTRIDGE_ROM_CHARACTER_0_END;
+					address += BUS_PAGE_LENGTH) {
+				m_page_tile[address >> BUS_PAGE_SHIFT] = m_mmu.page_tile(address - CARTRIDGE_ROM_CHARACTER_0_START,
+					BUS_PAGE_LENGTH);
+			}
+
+			TRACE_EXIT();
+		}
+
 		void
 		bus::mmu_interrupt(void)
 		{
@@ -515,6 +604,7 @@ namespace nescc {
 			m_cpu.uninitialize();
 			m_apu.uninitialize();
 			m_joypad.uninitialize();
+			unmap_pages();
 			m_mmu.uninitialize();
 			m_debug = false;
 			m_watch_cpu.clear();
@@ -558,7 +648,7 @@ namespace nescc {
 					result << m_mmu.rom_character(relative).as_string(relative, offset, 0, verbose);
 					break;
 				case PPU_NAMETABLE_START ... PPU_NAMETABLE_END: // 0x2000 - 0x3eff
-					result << m_ppu.nametable().as_string((address - PPU_NAMETABLE_START) % (PPU_NAMETABLE_LENGTH * 2),
+					result << m_ppu.nametable().as_string((address - PPU_NAMETABLE_START) % (PPU_NAMETABLE_LENGTH * PPU_NAMETABLE_COUNT),
 						offset, PPU_NAMETABLE_START, verbose);
 					break;
 				case PPU_PALETTE_START ... PPU_PALETTE_END: // 0x3f00 - 0x3fff
@@ -611,6 +701,33 @@ namespace nescc {
 			return result;
 		}
 
+		const uint8_t *
+		bus::ppu_read_tile(
+			__in uint16_t address
+			)
+		{
+			const uint8_t *result = nullptr;
+
+			TRACE_ENTRY_FORMAT("Address=%u(%04x)", address, address);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_BUS_EXCEPTION(NESCC_EMULATOR_BUS_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			if(address <= CARTRIDGE_ROM_CHARACTER_0_END) {
+				const uint8_t *page = m_page_tile[address >> BUS_PAGE_SHIFT];
+
+				if(page) {
+					result = (page + MMU_TILE_OFFSET(address & BUS_PAGE_MASK));
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
 		void
 		bus::ppu_set_mirroring(
 			__in uint8_t value
@@ -748,6 +865,34 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		bus::ppu_write_oam_page(
+			__in uint16_t address
+			)
+		{
+			uint8_t *page;
+
+			TRACE_ENTRY_FORMAT("Address=%u(%04x)", address, address);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_BUS_EXCEPTION(NESCC_EMULATOR_BUS_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			page = m_page_read[address >> BUS_PAGE_SHIFT];
+			if(page && !m_debug) {
+				m_ppu.write_oam_page(page + (address & BUS_PAGE_MASK));
+			} else {
+
+				for(uint16_t iter = 0; iter < PPU_OAM_LENGTH; ++iter) {
+					ppu_write_oam(iter, cpu_read(address + iter));
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		void
 		bus::reset(
 			__in_opt bool debug
@@ -768,6 +913,7 @@ namespace nescc {
 			m_cpu.reset(*this, true, debug);
 			m_ppu.reset(*this, debug);
 			m_debug = debug;
+			map_pages();
 
 			TRACE_DEBUG(m_debug, "Bus reset");
 
@@ -776,12 +922,30 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		bus::set_frame_skip(
+			__in uint32_t skip
+			)
+		{
+			TRACE_ENTRY_FORMAT("Skip=%u", skip);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_BUS_EXCEPTION(NESCC_EMULATOR_BUS_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			m_ppu.set_frame_skip(skip);
+
+			TRACE_EXIT();
+		}
+
 		void
 		bus::step(
 			__inout int32_t &cycle
 			)
 		{
-			uint8_t cycle_last, iter;
+			uint16_t cycle_last;
 
 			TRACE_ENTRY_FORMAT("Cycle=%i", cycle);
 
@@ -792,14 +956,10 @@ namespace nescc {
 #endif // NDEBUG
 
 			cycle_last = m_cpu.update(*this);
+			m_ppu.schedule(cycle_last * PPU_CYCLES_PER_CPU_CYCLE);
+			m_ppu.synchronize(*this);
 
-			for(iter = 0; iter < (cycle_last * PPU_CYCLES_PER_CPU_CYCLE); ++iter) {
-				m_ppu.update(*this);
-			}
-
-			for(iter = 0; iter < cycle_last; ++iter) {
-				m_apu.update(*this);
-			}
+			m_apu.update(*this, cycle_last);
 
 			cycle -= cycle_last;
 
@@ -867,6 +1027,23 @@ namespace nescc {
 			return result.str();
 		}
 
+		void
+		bus::unmap_pages(void)
+		{
+			TRACE_ENTRY();
+
+			for(uint32_t page = 0; page < BUS_PAGE_COUNT; ++page) {
+				m_page_read[page] = nullptr;
+				m_page_write[page] = nullptr;
+			}
+
+			for(uint32_t page = 0; page < BUS_PAGE_TILE_COUNT; ++page) {
+				m_page_tile[page] = nullptr;
+			}
+
+			TRACE_EXIT();
+		}
+
 		void
 		bus::update(
 			__inout int32_t &cycle
@@ -883,21 +1060,39 @@ namespace nescc {
 			cycle += CPU_CYCLES_PER_FRAME;
 
 			while(!m_cpu.halted() && (cycle > 0)) {
-				uint8_t cycle_last, iter;
-
-				cycle_last = m_cpu.update(*this);
+				uint16_t cycle_last = 0;
+				uint8_t idle = m_cpu.idle();
+
+				// an armed idle loop is only left through an interrupt or, for a status poll, the vertical blank flag,
+				// both of which arrive at a ppu or apu event, so its iterations up to the nearest event (or the end of
+				// the frame) are run forward in one step
+				if(idle != CPU_IDLE_NONE) {
+					cycle_last = m_cpu.update_idle(std::min(std::min((uint32_t) cycle, m_apu.schedule_limit()),
+						m_ppu.schedule_limit(idle == CPU_IDLE_POLL_STATUS) / PPU_CYCLES_PER_CPU_CYCLE));
+				}
 
-				for(iter = 0; iter < (cycle_last * PPU_CYCLES_PER_CPU_CYCLE); ++iter) {
-					m_ppu.update(*this);
+				if(!cycle_last) {
+					cycle_last = m_cpu.update(*this);
 				}
 
-				for(iter = 0; iter < cycle_last; ++iter) {
-					m_apu.update(*this);
+				// the ppu is only run forward ahead of the next instruction when one of the dots owed to it could
+				// signal an interrupt, otherwise it catches up on the next port access or at the end of the frame
+#if BUS_PPU_CATCH_UP
+				if(m_ppu.schedule(cycle_last * PPU_CYCLES_PER_CPU_CYCLE)) {
+					m_ppu.synchronize(*this);
 				}
+#else
+				m_ppu.schedule(cycle_last * PPU_CYCLES_PER_CPU_CYCLE);
+				m_ppu.synchronize(*this);
+#endif // BUS_PPU_CATCH_UP
+
+				m_apu.update(*this, cycle_last);
 
 				cycle -= cycle_last;
 			}
 
+			m_ppu.synchronize(*this);
+
 			if(m_cpu.halted()) {
 				m_display.update();
 			}
@@ -72,6 +72,10 @@ namespace nescc {
 		#define CARTRIDGE_ROM_PROGRAM_START (CARTRIDGE_RAM_PROGRAM_END + 1)
 		#define CARTRIDGE_ROM_PROGRAM_END (CARTRIDGE_ROM_PROGRAM_START + (2 * CARTRIDGE_ROM_PROGRAM_MAX) + 1)
 
+#ifndef BUS_PPU_CATCH_UP
+		#define BUS_PPU_CATCH_UP 1
+#endif // BUS_PPU_CATCH_UP
+
 		#define CPU_CYCLES_PER_FRAME 29781
 
 		#define CPU_RAM_END ((CPU_RAM_LENGTH * 4) - 1)
@@ -144,7 +144,7 @@ namespace nescc {
 			file.close();
 			m_loaded = true;
 			m_mapper = ((header.mapper_high << NIBBLE) | header.mapper_low);
-			m_mirroring = header.mirroring;
+			m_mirroring = (header.vram ? CARTRIDGE_MIRRORING_FOUR_SCREEN : header.mirroring);
 
 			TRACE_MESSAGE_FORMAT(TRACE_INFORMATION, "|-Version", "%u", (header.version == CARTRIDGE_VERSION_2)
 				? CARTRIDGE_VERSION_2 : CARTRIDGE_VERSION_1);
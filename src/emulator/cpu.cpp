@@ -16,8 +16,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <climits>
 #include "../../include/emulator/cpu.h"
+#include "../../include/emulator/bus.h"
 #include "../../include/emulator/ppu.h"
 #include "../../include/trace.h"
 #include "./cpu_type.h"
@@ -31,9 +33,16 @@ namespace nescc {
 			m_cycle(0),
 			m_debug(false),
 			m_flags(0),
+			m_flags_lazy(false),
+			m_flags_result(0),
 			m_halt(false),
+			m_idle(),
 			m_index_x(0),
 			m_index_y(0),
+			m_instruction(nullptr),
+			m_instruction_address(0),
+			m_instruction_generation(0),
+			m_oam_dma_stall(false),
 			m_program_counter(0),
 			m_signal_maskable(false),
 			m_signal_non_maskable(false),
@@ -84,15 +93,14 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_absolute(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint16_t result;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			result = read_word(bus, m_program_counter);
-			m_program_counter += MEMORY_WORD_LENGTH;
+			result = fetch_word(bus);
 
 			TRACE_EXIT_FORMAT("Result=%u(%04x)", result, result);
 			return result;
@@ -100,7 +108,7 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_absolute_x(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__inout bool &boundary
 			)
 		{
@@ -108,8 +116,7 @@ namespace nescc {
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			result = read_word(bus, m_program_counter);
-			m_program_counter += MEMORY_WORD_LENGTH;
+			result = fetch_word(bus);
 			boundary = (((result & UINT8_MAX) + m_index_x) > UINT8_MAX);
 			result += m_index_x;
 
@@ -119,7 +126,7 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_absolute_y(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__inout bool &boundary
 			)
 		{
@@ -127,8 +134,7 @@ namespace nescc {
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			result = read_word(bus, m_program_counter);
-			m_program_counter += MEMORY_WORD_LENGTH;
+			result = fetch_word(bus);
 			boundary = (((result & UINT8_MAX) + m_index_y) > UINT8_MAX);
 			result += m_index_y;
 
@@ -138,15 +144,14 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_indirect(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint16_t indirect, result;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			indirect = read_word(bus, m_program_counter);
-			m_program_counter += MEMORY_WORD_LENGTH;
+			indirect = fetch_word(bus);
 
 			if((indirect & UINT8_MAX) == UINT8_MAX) {
 				result = ((read_byte(bus, indirect - UINT8_MAX) << CHAR_BIT) | read_byte(bus, indirect));
@@ -160,7 +165,7 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_indirect_x(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t indirect;
@@ -168,7 +173,7 @@ namespace nescc {
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			indirect = read_byte(bus, m_program_counter++);
+			indirect = fetch_byte(bus);
 			indirect += m_index_x;
 			result = read_byte(bus, indirect++);
 			result |= (read_byte(bus, indirect) << CHAR_BIT);
@@ -179,7 +184,7 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_indirect_y(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__inout bool &boundary
 			)
 		{
@@ -188,7 +193,7 @@ namespace nescc {
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			indirect = read_byte(bus, m_program_counter++);
+			indirect = fetch_byte(bus);
 			result = read_byte(bus, indirect++);
 			result |= (read_byte(bus, indirect) << CHAR_BIT);
 			boundary = (((result & UINT8_MAX) + m_index_y) > UINT8_MAX);
@@ -198,9 +203,62 @@ namespace nescc {
 			return result;
 		}
 
+		template<uint8_t MODE> uint16_t
+		cpu::address_operand(
+			__in BUS_TYPE &bus,
+			__inout bool &boundary
+			)
+		{
+			uint16_t result = 0;
+
+			TRACE_ENTRY_FORMAT("Bus=%p, Mode=%s", &bus, CPU_MODE_STRING(MODE));
+
+			switch(MODE) {
+				case CPU_MODE_ABSOLUTE:
+					result = address_absolute(bus);
+					break;
+				case CPU_MODE_ABSOLUTE_X:
+					result = address_absolute_x(bus, boundary);
+					break;
+				case CPU_MODE_ABSOLUTE_Y:
+					result = address_absolute_y(bus, boundary);
+					break;
+				case CPU_MODE_IMMEDIATE:
+					result = m_program_counter++;
+					break;
+				case CPU_MODE_INDIRECT:
+					result = address_indirect(bus);
+					break;
+				case CPU_MODE_INDIRECT_X:
+					result = address_indirect_x(bus);
+					break;
+				case CPU_MODE_INDIRECT_Y:
+					result = address_indirect_y(bus, boundary);
+					break;
+				case CPU_MODE_RELATIVE:
+					result = address_relative(bus, boundary);
+					break;
+				case CPU_MODE_ZERO_PAGE:
+					result = address_zero_page(bus);
+					break;
+				case CPU_MODE_ZERO_PAGE_X:
+					result = address_zero_page_x(bus);
+					break;
+				case CPU_MODE_ZERO_PAGE_Y:
+					result = address_zero_page_y(bus);
+					break;
+				default:
+					THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_MODE,
+						"Address=%u(%04x), Mode=%u", m_program_counter, m_program_counter, MODE);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u(%04x), Boundary=%x", result, result, boundary);
+			return result;
+		}
+
 		uint16_t
 		cpu::address_relative(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__inout bool &boundary
 			)
 		{
@@ -209,7 +267,7 @@ namespace nescc {
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			relative = read_byte(bus, m_program_counter++);
+			relative = fetch_byte(bus);
 			result = (m_program_counter + relative);
 			boundary = ((m_program_counter & (UINT8_MAX << CHAR_BIT)) != (result & (UINT8_MAX << CHAR_BIT)));
 
@@ -219,14 +277,14 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_zero_page(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t result;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			result = read_byte(bus, m_program_counter++);
+			result = fetch_byte(bus);
 
 			TRACE_EXIT_FORMAT("Result=%u(%04x)", result, result);
 			return result;
@@ -234,14 +292,14 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_zero_page_x(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t result;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			result = read_byte(bus, m_program_counter++);
+			result = fetch_byte(bus);
 			result += m_index_x;
 
 			TRACE_EXIT_FORMAT("Result=%u(%04x)", result, result);
@@ -250,14 +308,14 @@ namespace nescc {
 
 		uint16_t
 		cpu::address_zero_page_y(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t result;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			result = read_byte(bus, m_program_counter++);
+			result = fetch_byte(bus);
 			result += m_index_y;
 
 			TRACE_EXIT_FORMAT("Result=%u(%04x)", result, result);
@@ -278,7 +336,7 @@ namespace nescc {
 				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "Y" << SCALAR_AS_HEX(uint8_t, m_index_y) << std::endl
 				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "PC" << SCALAR_AS_HEX(uint16_t, m_program_counter)
 				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "SP" << SCALAR_AS_HEX(uint8_t, m_stack_pointer) << std::endl
-				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "P" << SCALAR_AS_HEX(uint8_t, m_flags);
+				<< std::endl << std::left << std::setw(COLUMN_WIDTH) << "P" << SCALAR_AS_HEX(uint8_t, flags_evaluate());
 
 			if(verbose) {
 				int iter;
@@ -293,7 +351,7 @@ namespace nescc {
 				stream.str(std::string());
 
 				for(iter = CPU_FLAG_MAX; iter >= 0; iter--) {
-					stream << ((m_flags & (1 << iter)) ? "1" : "0");
+					stream << ((flags_evaluate() & (1 << iter)) ? "1" : "0");
 				}
 
 				result << std::endl << std::left << std::setw(COLUMN_WIDTH) << " " << "  "
@@ -330,7 +388,7 @@ namespace nescc {
 				}
 
 				result << SCALAR_AS_HEX(uint16_t, iter) << " -> ";
-				command = CPU_COMMAND_MAP.at(bank->read(iter));
+				command = CPU_COMMAND_MAP[bank->read(iter)];
 				length = CPU_MODE_LENGTH(command.second);
 				result << CPU_COMMAND_STRING(command.first);
 
@@ -447,10 +505,18 @@ namespace nescc {
 			m_cycle = 0;
 			m_debug = false;
 			m_flags = 0;
+			m_flags_lazy = false;
+			m_flags_result = 0;
 			m_halt = false;
+			m_idle = cpu_idle_t();
 			m_index_x =0;
 			m_index_y = 0;
+			m_instruction = nullptr;
+			m_instruction_address = 0;
+			m_instruction_cache.clear();
+			m_instruction_generation = 0;
 			m_oam_dma.clear();
+			m_oam_dma_stall = false;
 			m_program_counter = 0;
 			m_ram.clear();
 			m_signal_maskable = false;
@@ -464,7 +530,7 @@ namespace nescc {
 
 		std::string
 		cpu::command_as_string(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint16_t address,
 			__in_opt uint16_t offset,
 			__in_opt bool verbose
@@ -490,7 +556,7 @@ namespace nescc {
 				}
 
 				result << SCALAR_AS_HEX(uint16_t, program_counter) << " -> ";
-				command = CPU_COMMAND_MAP.at(bus.cpu_read(program_counter++));
+				command = CPU_COMMAND_MAP[bus.cpu_read(program_counter++)];
 				result << CPU_COMMAND_STRING(command.first);
 
 				switch(command.second) {
@@ -658,9 +724,563 @@ namespace nescc {
 			return m_cycle;
 		}
 
+		template<uint8_t OPCODE> uint8_t
+		cpu::execute(
+			__in BUS_TYPE &bus
+			)
+		{
+			uint8_t result;
+
+			TRACE_ENTRY_FORMAT("Bus=%p, Opcode=%u(%02x)", &bus, OPCODE, OPCODE);
+
+			result = execute_command<CPU_COMMAND_MAP[OPCODE].first, CPU_COMMAND_MAP[OPCODE].second>(bus);
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		uint8_t
+		cpu::execute_command(
+			__in BUS_TYPE &bus,
+			__in const std::pair<uint8_t, uint8_t> &command
+			)
+		{
+			uint8_t result = 0;
+
+			TRACE_ENTRY_FORMAT("Bus=%p, Command=%s %s", &bus, CPU_COMMAND_STRING(command.first),
+				CPU_MODE_STRING(command.second));
+
+			switch(command.first) {
+				case CPU_COMMAND_ADC:
+					result = execute_command_add(bus, command);
+					break;
+				case CPU_COMMAND_AND:
+					result = execute_command_and(bus, command);
+					break;
+				case CPU_COMMAND_ASL:
+					result = execute_command_shift_left(bus, command);
+					break;
+				case CPU_COMMAND_BCC:
+				case CPU_COMMAND_BCS:
+				case CPU_COMMAND_BEQ:
+				case CPU_COMMAND_BMI:
+				case CPU_COMMAND_BNE:
+				case CPU_COMMAND_BPL:
+				case CPU_COMMAND_BVC:
+				case CPU_COMMAND_BVS:
+					result = execute_command_branch(bus, command);
+					break;
+				case CPU_COMMAND_BIT:
+					result = execute_command_bit(bus, command);
+					break;
+				case CPU_COMMAND_BRK:
+					result = execute_command_break(bus, command);
+					break;
+				case CPU_COMMAND_CLC:
+				case CPU_COMMAND_CLD:
+				case CPU_COMMAND_CLI:
+				case CPU_COMMAND_CLV:
+				case CPU_COMMAND_SEC:
+				case CPU_COMMAND_SED:
+				case CPU_COMMAND_SEI:
+					result = execute_command_flag(command);
+					break;
+				case CPU_COMMAND_CMP:
+				case CPU_COMMAND_CPX:
+				case CPU_COMMAND_CPY:
+					result = execute_command_compare(bus, command);
+					break;
+				case CPU_COMMAND_DEC:
+				case CPU_COMMAND_DEX:
+				case CPU_COMMAND_DEY:
+					result = execute_command_decrement(bus, command);
+					break;
+				case CPU_COMMAND_EOR:
+					result = execute_command_or_exclusive(bus, command);
+					break;
+				case CPU_COMMAND_INC:
+				case CPU_COMMAND_INX:
+				case CPU_COMMAND_INY:
+					result = execute_command_increment(bus, command);
+					break;
+				case CPU_COMMAND_JMP:
+					result = execute_command_jump(bus, command);
+					break;
+				case CPU_COMMAND_JSR:
+					result = execute_command_subroutine(bus, command);
+					break;
+				case CPU_COMMAND_LDA:
+				case CPU_COMMAND_LDX:
+				case CPU_COMMAND_LDY:
+					result = execute_command_load(bus, command);
+					break;
+				case CPU_COMMAND_LSR:
+					result = execute_command_shift_right(bus, command);
+					break;
+				case CPU_COMMAND_NOP:
+					result = execute_command_nop(bus, command);
+					break;
+				case CPU_COMMAND_ORA:
+					result = execute_command_or(bus, command);
+					break;
+				case CPU_COMMAND_PHA:
+				case CPU_COMMAND_PHP:
+					result = execute_command_stack_push(bus, command);
+					break;
+				case CPU_COMMAND_PLA:
+				case CPU_COMMAND_PLP:
+					result = execute_command_stack_pull(bus, command);
+					break;
+				case CPU_COMMAND_ROL:
+					result = execute_command_rotate_left(bus, command);
+					break;
+				case CPU_COMMAND_ROR:
+					result = execute_command_rotate_right(bus, command);
+					break;
+				case CPU_COMMAND_RTI:
+					result = execute_command_return_interrupt(bus, command);
+					break;
+				case CPU_COMMAND_RTS:
+					result = execute_command_return(bus, command);
+					break;
+				case CPU_COMMAND_SBC:
+					result = execute_command_subtract(bus, command);
+					break;
+				case CPU_COMMAND_STA:
+				case CPU_COMMAND_STX:
+				case CPU_COMMAND_STY:
+					result = execute_command_store(bus, command);
+					break;
+				case CPU_COMMAND_TAX:
+				case CPU_COMMAND_TAY:
+				case CPU_COMMAND_TSX:
+				case CPU_COMMAND_TXA:
+				case CPU_COMMAND_TXS:
+				case CPU_COMMAND_TYA:
+					result = execute_command_transfer(command);
+					break;
+				default:
+					TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Illegal command", "Address=%u(%04x), Command=%u(%02x)(%s), Mode=%u(%s)",
+						(m_program_counter - 1), (m_program_counter - 1),
+						command.first, command.first, CPU_COMMAND_STRING(command.first),
+						command.second, CPU_MODE_STRING(command.second));
+					result = execute_command_illegal(bus, command);
+					break;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		template<uint8_t COMMAND, uint8_t MODE> uint8_t
+		cpu::execute_command(
+			__in BUS_TYPE &bus
+			)
+		{
+			uint16_t address = 0;
+			bool boundary = false, branch = false;
+			uint8_t result = CPU_MODE_CYCLES(MODE), value = 0;
+
+			TRACE_ENTRY_FORMAT("Bus=%p, Command=%s %s", &bus, CPU_COMMAND_STRING(COMMAND), CPU_MODE_STRING(MODE));
+
+			if(CPU_COMMAND_ILLEGAL(COMMAND)) {
+				TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Illegal command", "Address=%u(%04x), Command=%u(%02x)(%s), Mode=%u(%s)",
+					(m_program_counter - 1), (m_program_counter - 1), COMMAND, COMMAND, CPU_COMMAND_STRING(COMMAND),
+					MODE, CPU_MODE_STRING(MODE));
+			}
+
+			switch(COMMAND) {
+				case CPU_COMMAND_ADC:
+					m_accumulator = add(read_operand<MODE>(bus, boundary));
+					value = m_accumulator;
+					break;
+				case CPU_COMMAND_AND:
+					m_accumulator &= read_operand<MODE>(bus, boundary);
+					value = m_accumulator;
+					break;
+				case CPU_COMMAND_ASL:
+
+					if(MODE == CPU_MODE_ACCUMULATOR) {
+						value = m_accumulator = shift_left(m_accumulator);
+					} else {
+						address = address_operand<MODE>(bus, boundary);
+						value = shift_left(read_byte(bus, address));
+						write_byte(bus, address, value);
+						result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					}
+					break;
+				case CPU_COMMAND_BCC:
+				case CPU_COMMAND_BCS:
+				case CPU_COMMAND_BEQ:
+				case CPU_COMMAND_BMI:
+				case CPU_COMMAND_BNE:
+				case CPU_COMMAND_BPL:
+				case CPU_COMMAND_BVC:
+				case CPU_COMMAND_BVS:
+
+					switch(COMMAND) {
+						case CPU_COMMAND_BCC:
+							branch = !(m_flags & CPU_FLAG_CARRY);
+							break;
+						case CPU_COMMAND_BCS:
+							branch = (m_flags & CPU_FLAG_CARRY);
+							break;
+						case CPU_COMMAND_BEQ:
+							branch = (flags_evaluate() & CPU_FLAG_ZERO);
+							break;
+						case CPU_COMMAND_BMI:
+							branch = (flags_evaluate() & CPU_FLAG_SIGN);
+							break;
+						case CPU_COMMAND_BNE:
+							branch = !(flags_evaluate() & CPU_FLAG_ZERO);
+							break;
+						case CPU_COMMAND_BPL:
+							branch = !(flags_evaluate() & CPU_FLAG_SIGN);
+							break;
+						case CPU_COMMAND_BVC:
+							branch = !(m_flags & CPU_FLAG_OVERFLOW);
+							break;
+						case CPU_COMMAND_BVS:
+							branch = (m_flags & CPU_FLAG_OVERFLOW);
+							break;
+					}
+
+					address = address_operand<MODE>(bus, boundary);
+
+					if(branch) {
+						m_program_counter = address;
+						result += CPU_CYCLES_BRANCH;
+					}
+					break;
+				case CPU_COMMAND_BIT:
+					value = read_operand<MODE>(bus, boundary);
+					(value & CPU_FLAG_OVERFLOW) ? m_flags |= CPU_FLAG_OVERFLOW : m_flags &= ~CPU_FLAG_OVERFLOW;
+					(value & CPU_FLAG_SIGN) ? m_flags |= CPU_FLAG_SIGN : m_flags &= ~CPU_FLAG_SIGN;
+					!(value & m_accumulator) ? m_flags |= CPU_FLAG_ZERO : m_flags &= ~CPU_FLAG_ZERO;
+					m_flags_lazy = false;
+					break;
+				case CPU_COMMAND_BRK:
+					push_word(bus, m_program_counter + 1);
+					push_byte(bus, flags_evaluate() | CPU_FLAG_BREAK);
+					m_flags |= CPU_FLAG_INTERRUPT_DISABLE;
+					m_program_counter = read_word(bus, CPU_INTERRUPT_MASKABLE_ADDRESS);
+					break;
+				case CPU_COMMAND_CLC:
+					m_flags &= ~CPU_FLAG_CARRY;
+					break;
+				case CPU_COMMAND_CLD:
+					m_flags &= ~CPU_FLAG_DECIMAL;
+					break;
+				case CPU_COMMAND_CLI:
+					m_flags &= ~CPU_FLAG_INTERRUPT_DISABLE;
+					break;
+				case CPU_COMMAND_CLV:
+					m_flags &= ~CPU_FLAG_OVERFLOW;
+					break;
+				case CPU_COMMAND_CMP:
+					value = read_operand<MODE>(bus, boundary);
+					(m_accumulator >= value) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					value = (m_accumulator - value);
+					break;
+				case CPU_COMMAND_CPX:
+					value = read_operand<MODE>(bus, boundary);
+					(m_index_x >= value) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					value = (m_index_x - value);
+					break;
+				case CPU_COMMAND_CPY:
+					value = read_operand<MODE>(bus, boundary);
+					(m_index_y >= value) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					value = (m_index_y - value);
+					break;
+				case CPU_COMMAND_DEC:
+					address = address_operand<MODE>(bus, boundary);
+					value = read_byte(bus, address);
+					write_byte(bus, address, --value);
+					result += CPU_CYCLES_READ_WRITE;
+					break;
+				case CPU_COMMAND_DEX:
+					value = --m_index_x;
+					break;
+				case CPU_COMMAND_DEY:
+					value = --m_index_y;
+					break;
+				case CPU_COMMAND_EOR:
+					m_accumulator ^= read_operand<MODE>(bus, boundary);
+					value = m_accumulator;
+					break;
+				case CPU_COMMAND_INC:
+					address = address_operand<MODE>(bus, boundary);
+					value = read_byte(bus, address);
+					write_byte(bus, address, ++value);
+					result += CPU_CYCLES_READ_WRITE;
+					break;
+				case CPU_COMMAND_INX:
+					value = ++m_index_x;
+					break;
+				case CPU_COMMAND_INY:
+					value = ++m_index_y;
+					break;
+				case CPU_COMMAND_JMP:
+					m_program_counter = address_operand<MODE>(bus, boundary);
+
+					if(MODE == CPU_MODE_ABSOLUTE) {
+						--result;
+					}
+					break;
+				case CPU_COMMAND_JSR:
+					address = address_operand<MODE>(bus, boundary);
+					push_word(bus, (m_program_counter - 1));
+					m_program_counter = address;
+					result += CPU_CYCLES_READ_WRITE;
+					break;
+				case CPU_COMMAND_LDA:
+					value = m_accumulator = read_operand<MODE>(bus, boundary);
+					break;
+				case CPU_COMMAND_LDX:
+					value = m_index_x = read_operand<MODE>(bus, boundary);
+					break;
+				case CPU_COMMAND_LDY:
+					value = m_index_y = read_operand<MODE>(bus, boundary);
+					break;
+				case CPU_COMMAND_LSR:
+
+					if(MODE == CPU_MODE_ACCUMULATOR) {
+						value = m_accumulator = shift_right(m_accumulator);
+					} else {
+						address = address_operand<MODE>(bus, boundary);
+						value = shift_right(read_byte(bus, address));
+						write_byte(bus, address, value);
+						result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					}
+					break;
+				case CPU_COMMAND_NOP:
+					break;
+				case CPU_COMMAND_ORA:
+					m_accumulator |= read_operand<MODE>(bus, boundary);
+					value = m_accumulator;
+					break;
+				case CPU_COMMAND_PHA:
+					push_byte(bus, m_accumulator);
+					break;
+				case CPU_COMMAND_PHP:
+					push_byte(bus, flags_evaluate() | CPU_FLAG_BREAK);
+					break;
+				case CPU_COMMAND_PLA:
+					value = m_accumulator = pull_byte(bus);
+					break;
+				case CPU_COMMAND_PLP:
+					m_flags = ((pull_byte(bus) | CPU_FLAG_UNUSED) & ~CPU_FLAG_BREAK);
+					m_flags_lazy = false;
+					break;
+				case CPU_COMMAND_ROL:
+
+					if(MODE == CPU_MODE_ACCUMULATOR) {
+						value = m_accumulator = rotate_left(m_accumulator);
+					} else {
+						address = address_operand<MODE>(bus, boundary);
+						value = rotate_left(read_byte(bus, address));
+						write_byte(bus, address, value);
+						result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					}
+					break;
+				case CPU_COMMAND_ROR:
+
+					if(MODE == CPU_MODE_ACCUMULATOR) {
+						value = m_accumulator = rotate_right(m_accumulator);
+					} else {
+						address = address_operand<MODE>(bus, boundary);
+						value = rotate_right(read_byte(bus, address));
+						write_byte(bus, address, value);
+						result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					}
+					break;
+				case CPU_COMMAND_RTI:
+					m_flags = ((pull_byte(bus) | CPU_FLAG_UNUSED) & ~CPU_FLAG_BREAK);
+					m_flags_lazy = false;
+					m_program_counter = pull_word(bus);
+					break;
+				case CPU_COMMAND_RTS:
+					m_program_counter = (pull_word(bus) + 1);
+					break;
+				case CPU_COMMAND_SBC:
+				case CPU_COMMAND_ILLEGAL_SBC:
+					m_accumulator = add(~read_operand<MODE>(bus, boundary));
+					value = m_accumulator;
+					break;
+				case CPU_COMMAND_SEC:
+					m_flags |= CPU_FLAG_CARRY;
+					break;
+				case CPU_COMMAND_SED:
+					m_flags |= CPU_FLAG_DECIMAL;
+					break;
+				case CPU_COMMAND_SEI:
+					m_flags |= CPU_FLAG_INTERRUPT_DISABLE;
+					break;
+				case CPU_COMMAND_STA:
+					write_byte(bus, address_operand<MODE>(bus, boundary), m_accumulator);
+					result += CPU_MODE_BOUNDARY_CYCLES(MODE);
+					break;
+				case CPU_COMMAND_STX:
+					write_byte(bus, address_operand<MODE>(bus, boundary), m_index_x);
+					break;
+				case CPU_COMMAND_STY:
+					write_byte(bus, address_operand<MODE>(bus, boundary), m_index_y);
+					break;
+				case CPU_COMMAND_TAX:
+					value = m_index_x = m_accumulator;
+					break;
+				case CPU_COMMAND_TAY:
+					value = m_index_y = m_accumulator;
+					break;
+				case CPU_COMMAND_TSX:
+					value = m_index_x = m_stack_pointer;
+					break;
+				case CPU_COMMAND_TXA:
+					value = m_accumulator = m_index_x;
+					break;
+				case CPU_COMMAND_TXS:
+					m_stack_pointer = m_index_x;
+					break;
+				case CPU_COMMAND_TYA:
+					value = m_accumulator = m_index_y;
+					break;
+				case CPU_COMMAND_ILLEGAL_AHX:
+					address = address_operand<MODE>(bus, boundary);
+					write_byte(bus, address, m_accumulator & m_index_x & ((address >> CHAR_BIT) + 1));
+					result += CPU_MODE_BOUNDARY_CYCLES(MODE);
+					break;
+				case CPU_COMMAND_ILLEGAL_ALR:
+					value = m_accumulator = shift_right(read_operand<MODE>(bus, boundary) & m_accumulator);
+					break;
+				case CPU_COMMAND_ILLEGAL_ANC:
+					value = m_accumulator &= read_operand<MODE>(bus, boundary);
+					(value & CPU_FLAG_SIGN) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					break;
+				case CPU_COMMAND_ILLEGAL_ARR:
+					m_accumulator &= read_operand<MODE>(bus, boundary);
+					m_accumulator >>= 1;
+					(m_flags & CPU_FLAG_CARRY) ? m_accumulator |= CPU_FLAG_SIGN : m_accumulator &= ~CPU_FLAG_SIGN;
+					((m_accumulator >> 6) & 1) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					(((m_accumulator >> 6) & 1) ^ ((m_accumulator >> 5) & 1)) ? m_flags |= CPU_FLAG_OVERFLOW
+						: m_flags &= ~CPU_FLAG_OVERFLOW;
+					value = m_accumulator;
+					break;
+				case CPU_COMMAND_ILLEGAL_AXS:
+					value = read_operand<MODE>(bus, boundary);
+					m_index_x &= m_accumulator;
+					(m_index_x >= value) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					m_index_x -= value;
+					value = m_index_x;
+					break;
+				case CPU_COMMAND_ILLEGAL_DCP:
+					address = address_operand<MODE>(bus, boundary);
+					value = read_byte(bus, address);
+					write_byte(bus, address, --value);
+					result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					(m_accumulator >= value) ? m_flags |= CPU_FLAG_CARRY : m_flags &= ~CPU_FLAG_CARRY;
+					value = (m_accumulator - value);
+					break;
+				case CPU_COMMAND_ILLEGAL_ISC:
+					address = address_operand<MODE>(bus, boundary);
+					value = read_byte(bus, address);
+					write_byte(bus, address, ++value);
+					result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					value = m_accumulator = add(~value);
+					break;
+				case CPU_COMMAND_ILLEGAL_KIL:
+					m_halt = true;
+					bus.display_halt(true);
+					result = 0;
+					break;
+				case CPU_COMMAND_ILLEGAL_LAS:
+					value = m_accumulator = m_index_x = m_stack_pointer = (read_operand<MODE>(bus, boundary) & m_stack_pointer);
+					break;
+				case CPU_COMMAND_ILLEGAL_LAX:
+					value = m_accumulator = m_index_x = read_operand<MODE>(bus, boundary);
+					break;
+				case CPU_COMMAND_ILLEGAL_NOP:
+
+					if(MODE != CPU_MODE_IMPLIED) {
+						address_operand<MODE>(bus, boundary);
+					}
+					break;
+				case CPU_COMMAND_ILLEGAL_RLA:
+					address = address_operand<MODE>(bus, boundary);
+					value = rotate_left(read_byte(bus, address));
+					write_byte(bus, address, value);
+					result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					value = m_accumulator &= value;
+					break;
+				case CPU_COMMAND_ILLEGAL_RRA:
+					address = address_operand<MODE>(bus, boundary);
+					value = rotate_right(read_byte(bus, address));
+					write_byte(bus, address, value);
+					result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					value = m_accumulator = add(value);
+					break;
+				case CPU_COMMAND_ILLEGAL_SAX:
+					write_byte(bus, address_operand<MODE>(bus, boundary), m_accumulator & m_index_x);
+					break;
+				case CPU_COMMAND_ILLEGAL_SHX:
+					address = address_operand<MODE>(bus, boundary);
+					write_byte(bus, address, m_index_x & ((address >> CHAR_BIT) + 1));
+					result += CPU_MODE_BOUNDARY_CYCLES(MODE);
+					break;
+				case CPU_COMMAND_ILLEGAL_SHY:
+					address = address_operand<MODE>(bus, boundary);
+					write_byte(bus, address, m_index_y & ((address >> CHAR_BIT) + 1));
+					result += CPU_MODE_BOUNDARY_CYCLES(MODE);
+					break;
+				case CPU_COMMAND_ILLEGAL_SLO:
+					address = address_operand<MODE>(bus, boundary);
+					value = shift_left(read_byte(bus, address));
+					write_byte(bus, address, value);
+					result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					value = m_accumulator |= value;
+					break;
+				case CPU_COMMAND_ILLEGAL_SRE:
+					address = address_operand<MODE>(bus, boundary);
+					value = shift_right(read_byte(bus, address));
+					write_byte(bus, address, value);
+					result += (CPU_CYCLES_READ_WRITE + CPU_MODE_BOUNDARY_CYCLES(MODE));
+					value = m_accumulator ^= value;
+					break;
+				case CPU_COMMAND_ILLEGAL_TAS:
+					address = address_operand<MODE>(bus, boundary);
+					m_stack_pointer = (m_accumulator & m_index_x);
+					write_byte(bus, address, m_stack_pointer & ((address >> CHAR_BIT) + 1));
+					result += CPU_MODE_BOUNDARY_CYCLES(MODE);
+					break;
+				case CPU_COMMAND_ILLEGAL_XAA:
+					value = m_accumulator = (read_operand<MODE>(bus, boundary) & m_index_x);
+					break;
+				default:
+					THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_COMMAND,
+						"Address=%u(%04x), Command=%u(%02x), Mode=%u", m_program_counter, m_program_counter,
+						COMMAND, COMMAND, MODE);
+			}
+
+			if(CPU_COMMAND_ATTRIBUTE(COMMAND, CPU_COMMAND_ATTRIBUTE_BOUNDARY) && boundary) {
+				result += CPU_CYCLES_PAGE_BOUNDARY;
+			}
+
+			if(CPU_COMMAND_ATTRIBUTE(COMMAND, CPU_COMMAND_ATTRIBUTE_ZERO_SIGN)) {
+#if CPU_FLAGS_LAZY
+				m_flags_lazy = true;
+				m_flags_result = value;
+#else
+				!value ? m_flags |= CPU_FLAG_ZERO : m_flags &= ~CPU_FLAG_ZERO;
+				(value & CPU_FLAG_SIGN) ? m_flags |= CPU_FLAG_SIGN : m_flags &= ~CPU_FLAG_SIGN;
+#endif // CPU_FLAGS_LAZY
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
 		uint8_t
 		cpu::execute_command_add(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -681,7 +1301,7 @@ namespace nescc {
 					m_accumulator = add(read_byte(bus, address_absolute_y(bus, boundary)));
 					break;
 				case CPU_MODE_IMMEDIATE:
-					m_accumulator = add(read_byte(bus, m_program_counter++));
+					m_accumulator = add(fetch_byte(bus));
 					break;
 				case CPU_MODE_INDIRECT_X:
 					m_accumulator = add(read_byte(bus, address_indirect_x(bus)));
@@ -714,7 +1334,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_and(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -735,7 +1355,7 @@ namespace nescc {
 					m_accumulator &= read_byte(bus, address_absolute_y(bus, boundary));
 					break;
 				case CPU_MODE_IMMEDIATE:
-					m_accumulator &= read_byte(bus, m_program_counter++);
+					m_accumulator &= fetch_byte(bus);
 					break;
 				case CPU_MODE_INDIRECT_X:
 					m_accumulator &= read_byte(bus, address_indirect_x(bus));
@@ -768,7 +1388,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_bit(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -801,7 +1421,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_branch(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -820,16 +1440,16 @@ namespace nescc {
 					branch = (m_flags & CPU_FLAG_CARRY);
 					break;
 				case CPU_COMMAND_BEQ:
-					branch = (m_flags & CPU_FLAG_ZERO);
+					branch = (flags_evaluate() & CPU_FLAG_ZERO);
 					break;
 				case CPU_COMMAND_BMI:
-					branch = (m_flags & CPU_FLAG_SIGN);
+					branch = (flags_evaluate() & CPU_FLAG_SIGN);
 					break;
 				case CPU_COMMAND_BNE:
-					branch = !(m_flags & CPU_FLAG_ZERO);
+					branch = !(flags_evaluate() & CPU_FLAG_ZERO);
 					break;
 				case CPU_COMMAND_BPL:
-					branch = !(m_flags & CPU_FLAG_SIGN);
+					branch = !(flags_evaluate() & CPU_FLAG_SIGN);
 					break;
 				case CPU_COMMAND_BVC:
 					branch = !(m_flags & CPU_FLAG_OVERFLOW);
@@ -860,7 +1480,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_break(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -870,7 +1490,7 @@ namespace nescc {
 				CPU_MODE_STRING(command.second));
 
 			push_word(bus, m_program_counter + 1);
-			push_byte(bus, m_flags | CPU_FLAG_BREAK);
+			push_byte(bus, flags_evaluate() | CPU_FLAG_BREAK);
 			m_flags |= CPU_FLAG_INTERRUPT_DISABLE;
 			m_program_counter = read_word(bus, CPU_INTERRUPT_MASKABLE_ADDRESS);
 
@@ -880,7 +1500,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_compare(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -904,7 +1524,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute_y(bus, boundary));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_INDIRECT_X:
 							value = read_byte(bus, address_indirect_x(bus));
@@ -938,7 +1558,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute(bus));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_ZERO_PAGE:
 							value = read_byte(bus, address_zero_page(bus));
@@ -959,7 +1579,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute(bus));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_ZERO_PAGE:
 							value = read_byte(bus, address_zero_page(bus));
@@ -988,7 +1608,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_decrement(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1092,7 +1712,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1157,7 +1777,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_decrement(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1213,7 +1833,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_halt(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1231,7 +1851,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_increment(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1286,7 +1906,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_load(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1301,7 +1921,7 @@ namespace nescc {
 
 					switch(command.second) {
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						default:
 							THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_MODE,
@@ -1316,7 +1936,7 @@ namespace nescc {
 
 					switch(command.second) {
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						default:
 							THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_MODE,
@@ -1332,7 +1952,7 @@ namespace nescc {
 
 					switch(command.second) {
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						default:
 							THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_MODE,
@@ -1352,7 +1972,7 @@ namespace nescc {
 
 					switch(command.second) {
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						default:
 							THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_MODE,
@@ -1392,7 +2012,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute_y(bus, boundary));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_INDIRECT_X:
 							value = read_byte(bus, address_indirect_x(bus));
@@ -1419,7 +2039,7 @@ namespace nescc {
 
 					switch(command.second) {
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						default:
 							THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_MODE,
@@ -1449,7 +2069,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_nop(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1493,7 +2113,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_rotate_left(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1548,7 +2168,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_rotate_right(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1603,7 +2223,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_shift_left(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1658,7 +2278,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_shift_right(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1713,7 +2333,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_store(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1821,7 +2441,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_illegal_subtract(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1838,7 +2458,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_increment(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1900,7 +2520,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_jump(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1929,7 +2549,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_load(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -1953,7 +2573,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute_y(bus, boundary));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_INDIRECT_X:
 							value = read_byte(bus, address_indirect_x(bus));
@@ -1985,7 +2605,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute_y(bus, boundary));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_ZERO_PAGE:
 							value = read_byte(bus, address_zero_page(bus));
@@ -2011,7 +2631,7 @@ namespace nescc {
 							value = read_byte(bus, address_absolute_x(bus, boundary));
 							break;
 						case CPU_MODE_IMMEDIATE:
-							value = read_byte(bus, m_program_counter++);
+							value = fetch_byte(bus);
 							break;
 						case CPU_MODE_ZERO_PAGE:
 							value = read_byte(bus, address_zero_page(bus));
@@ -2046,7 +2666,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_nop(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2060,7 +2680,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_or(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2081,7 +2701,7 @@ namespace nescc {
 					m_accumulator |= read_byte(bus, address_absolute_y(bus, boundary));
 					break;
 				case CPU_MODE_IMMEDIATE:
-					m_accumulator |= read_byte(bus, m_program_counter++);
+					m_accumulator |= fetch_byte(bus);
 					break;
 				case CPU_MODE_INDIRECT_X:
 					m_accumulator |= read_byte(bus, address_indirect_x(bus));
@@ -2114,7 +2734,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_or_exclusive(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2135,7 +2755,7 @@ namespace nescc {
 					m_accumulator ^= read_byte(bus, address_absolute_y(bus, boundary));
 					break;
 				case CPU_MODE_IMMEDIATE:
-					m_accumulator ^= read_byte(bus, m_program_counter++);
+					m_accumulator ^= fetch_byte(bus);
 					break;
 				case CPU_MODE_INDIRECT_X:
 					m_accumulator ^= read_byte(bus, address_indirect_x(bus));
@@ -2168,7 +2788,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_rotate_left(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2222,7 +2842,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_rotate_right(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2276,7 +2896,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_return(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2293,7 +2913,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_return_interrupt(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2303,6 +2923,7 @@ namespace nescc {
 				CPU_MODE_STRING(command.second));
 
 			m_flags = ((pull_byte(bus) | CPU_FLAG_UNUSED) & ~CPU_FLAG_BREAK);
+			m_flags_lazy = false;
 			m_program_counter = pull_word(bus);
 
 			TRACE_EXIT_FORMAT("Result=%u", result);
@@ -2311,7 +2932,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_shift_left(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2365,7 +2986,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_shift_right(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2419,7 +3040,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_stack_pull(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2436,6 +3057,7 @@ namespace nescc {
 					break;
 				case CPU_COMMAND_PLP:
 					m_flags = ((pull_byte(bus) | CPU_FLAG_UNUSED) & ~CPU_FLAG_BREAK);
+					m_flags_lazy = false;
 					break;
 				default:
 					THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_STACK_PULL,
@@ -2449,7 +3071,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_stack_push(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2463,7 +3085,7 @@ namespace nescc {
 					push_byte(bus, m_accumulator);
 					break;
 				case CPU_COMMAND_PHP:
-					push_byte(bus, m_flags | CPU_FLAG_BREAK);
+					push_byte(bus, flags_evaluate() | CPU_FLAG_BREAK);
 					break;
 				default:
 					THROW_NESCC_EMULATOR_CPU_EXCEPTION_FORMAT(NESCC_EMULATOR_CPU_EXCEPTION_UNSUPPORTED_STACK_PUSH,
@@ -2477,7 +3099,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_store(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2569,7 +3191,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_subroutine(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2589,7 +3211,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::execute_command_subtract(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in const std::pair<uint8_t, uint8_t> &command
 			)
 		{
@@ -2610,7 +3232,7 @@ namespace nescc {
 					m_accumulator = add(~read_byte(bus, address_absolute_y(bus, boundary)));
 					break;
 				case CPU_MODE_IMMEDIATE:
-					m_accumulator = add(~read_byte(bus, m_program_counter++));
+					m_accumulator = add(~fetch_byte(bus));
 					break;
 				case CPU_MODE_INDIRECT_X:
 					m_accumulator = add(~read_byte(bus, address_indirect_x(bus)));
@@ -2685,6 +3307,73 @@ namespace nescc {
 			return result;
 		}
 
+		uint8_t
+		cpu::fetch_byte(
+			__in BUS_TYPE &bus
+			)
+		{
+			uint16_t offset;
+			uint8_t result;
+
+			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+
+			offset = (m_program_counter - m_instruction_address);
+			if(m_instruction && (offset < m_instruction->length)) {
+				result = m_instruction->data[offset];
+			} else {
+				result = read_byte(bus, m_program_counter);
+			}
+
+			++m_program_counter;
+
+			TRACE_EXIT_FORMAT("Result=%u(%02x)", result, result);
+			return result;
+		}
+
+		cpu_instruction_t *
+		cpu::fetch_instruction(
+			__in BUS_TYPE &bus
+			)
+		{
+			cpu_instruction_t *result = nullptr;
+
+			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+
+			if((m_program_counter >= CPU_INSTRUCTION_CACHE_START) && (m_program_counter <= CPU_INSTRUCTION_CACHE_END)) {
+				result = &m_instruction_cache[m_program_counter - CPU_INSTRUCTION_CACHE_START];
+
+				if(result->generation != m_instruction_generation) {
+					result->data[0] = read_byte(bus, m_program_counter);
+					result->length = CPU_MODE_LENGTH(CPU_COMMAND_MAP[result->data[0]].second);
+
+					for(uint8_t iter = 1; iter < result->length; ++iter) {
+						result->data[iter] = read_byte(bus, m_program_counter + iter);
+					}
+
+					result->generation = m_instruction_generation;
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
+		uint16_t
+		cpu::fetch_word(
+			__in BUS_TYPE &bus
+			)
+		{
+			uint16_t result;
+
+			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+
+			result = fetch_byte(bus);
+			result |= (fetch_byte(bus) << CHAR_BIT);
+
+			TRACE_EXIT_FORMAT("Result=%u(%04x)", result, result);
+			return result;
+		}
+
 		uint8_t
 		cpu::flags(void) const
 		{
@@ -2696,8 +3385,30 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			TRACE_EXIT_FORMAT("Result=%u(%02x)", m_flags, m_flags);
-			return m_flags;
+			uint8_t result = flags_evaluate();
+
+			TRACE_EXIT_FORMAT("Result=%u(%02x)", result, result);
+			return result;
+		}
+
+		uint8_t
+		cpu::flags_evaluate(void) const
+		{
+			uint8_t result = m_flags;
+
+			TRACE_ENTRY();
+
+			if(m_flags_lazy) {
+				result &= ~(CPU_FLAG_SIGN | CPU_FLAG_ZERO);
+				result |= (m_flags_result & CPU_FLAG_SIGN);
+
+				if(!m_flags_result) {
+					result |= CPU_FLAG_ZERO;
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u(%02x)", result, result);
+			return result;
 		}
 
 		bool
@@ -2715,6 +3426,125 @@ namespace nescc {
 			return m_halt;
 		}
 
+		uint8_t
+		cpu::idle(void) const
+		{
+			uint8_t result = CPU_IDLE_NONE;
+
+			TRACE_ENTRY();
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_CPU_EXCEPTION(NESCC_EMULATOR_CPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+#if CPU_IDLE
+			// only an armed loop about to start an iteration, with no interrupt pending and its polled ram unchanged,
+			// can be run forward
+			if(m_idle.length && !m_idle.index && !m_signal_maskable && !m_signal_non_maskable
+					&& ((m_idle.type != CPU_IDLE_POLL_RAM) || (m_ram.read(m_idle.watch) == m_idle.watch_value))) {
+				result = m_idle.type;
+			}
+#endif // CPU_IDLE
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		void
+		cpu::idle_detect(
+			__in uint8_t cycles
+			)
+		{
+			TRACE_ENTRY_FORMAT("Cycles=%u", cycles);
+
+			if(m_instruction) {
+				const std::pair<uint8_t, uint8_t> &command = CPU_COMMAND_MAP[m_instruction->data[0]];
+
+				switch(command.first) {
+					case CPU_COMMAND_BCC:
+					case CPU_COMMAND_BCS:
+					case CPU_COMMAND_BEQ:
+					case CPU_COMMAND_BMI:
+					case CPU_COMMAND_BNE:
+					case CPU_COMMAND_BPL:
+					case CPU_COMMAND_BVC:
+					case CPU_COMMAND_BVS:
+
+						// poll loop: a ram load, followed by a branch taken back to it
+						if(m_idle.previous && (m_idle.previous->generation == m_instruction_generation)
+								&& (m_program_counter == m_idle.previous_address)) {
+							const std::pair<uint8_t, uint8_t> &poll = CPU_COMMAND_MAP[m_idle.previous->data[0]];
+
+							switch(poll.first) {
+								case CPU_COMMAND_BIT:
+								case CPU_COMMAND_LDA:
+								case CPU_COMMAND_LDX:
+								case CPU_COMMAND_LDY:
+
+									if((poll.second == CPU_MODE_ABSOLUTE) || (poll.second == CPU_MODE_ZERO_PAGE)) {
+										uint8_t type = CPU_IDLE_NONE;
+										uint16_t watch = m_idle.previous->data[1];
+
+										if(poll.second == CPU_MODE_ABSOLUTE) {
+											watch |= (m_idle.previous->data[2] << CHAR_BIT);
+										}
+
+										if(watch < (CPU_RAM_LENGTH * 4)) {
+											type = CPU_IDLE_POLL_RAM;
+											m_idle.watch = (watch % CPU_RAM_LENGTH);
+											m_idle.watch_value = m_ram.raw()[m_idle.watch];
+										} else if((command.first == CPU_COMMAND_BPL)
+												&& (watch >= CPU_IDLE_STATUS_START) && (watch <= CPU_IDLE_STATUS_END)
+												&& (((watch - CPU_IDLE_STATUS_START) % (PPU_PORT_MAX + 1))
+													== PPU_PORT_STATUS)) {
+
+											// vblank poll: the branch stays taken while the vertical blank flag reads
+											// clear, which only changes at the vertical blank dot (a bmi loop clears
+											// the flag it polls, so it is left to run)
+											type = CPU_IDLE_POLL_STATUS;
+										}
+
+										if(type != CPU_IDLE_NONE) {
+											m_idle.address[0] = m_idle.previous_address;
+											m_idle.address[1] = m_instruction_address;
+											m_idle.cycles[0] = m_idle.previous_cycles;
+											m_idle.cycles[1] = cycles;
+											m_idle.index = 0;
+											m_idle.length = 2;
+											m_idle.type = type;
+										}
+									}
+									break;
+								default:
+									break;
+							}
+						}
+						break;
+					case CPU_COMMAND_JMP:
+
+						// jump loop: an absolute jump to itself
+						if((command.second == CPU_MODE_ABSOLUTE) && (m_program_counter == m_instruction_address)) {
+							m_idle.address[0] = m_instruction_address;
+							m_idle.cycles[0] = cycles;
+							m_idle.index = 0;
+							m_idle.length = 1;
+							m_idle.type = CPU_IDLE_JUMP;
+						}
+						break;
+					default:
+						break;
+				}
+			}
+
+			m_idle.previous = m_instruction;
+			m_idle.previous_address = m_instruction_address;
+			m_idle.previous_cycles = cycles;
+
+			TRACE_EXIT();
+		}
+
 		uint8_t
 		cpu::index_x(void) const
 		{
@@ -2762,7 +3592,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::interrupt_maskable(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t result = CPU_MODE_CYCLES(CPU_MODE_INTERRUPT);
@@ -2772,8 +3602,9 @@ namespace nescc {
 			TRACE_DEBUG(m_debug, "Cpu maskable interrupt");
 
 			push_word(bus, m_program_counter);
-			push_byte(bus, m_flags & ~CPU_FLAG_BREAK);
+			push_byte(bus, flags_evaluate() & ~CPU_FLAG_BREAK);
 			m_flags |= CPU_FLAG_INTERRUPT_DISABLE;
+			m_idle.length = 0;
 			m_program_counter = read_word(bus, CPU_INTERRUPT_MASKABLE_ADDRESS);
 
 			TRACE_DEBUG_FORMAT(m_debug, "Cpu state", "\n%s", STRING_CHECK(as_string(true)));
@@ -2801,7 +3632,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::interrupt_non_maskable(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t result = CPU_MODE_CYCLES(CPU_MODE_INTERRUPT);
@@ -2811,8 +3642,9 @@ namespace nescc {
 			TRACE_DEBUG(m_debug, "Cpu non-maskable interrupt");
 
 			push_word(bus, m_program_counter);
-			push_byte(bus, m_flags & ~CPU_FLAG_BREAK);
+			push_byte(bus, flags_evaluate() & ~CPU_FLAG_BREAK);
 			m_flags |= CPU_FLAG_INTERRUPT_DISABLE;
+			m_idle.length = 0;
 			m_program_counter = read_word(bus, CPU_INTERRUPT_NON_MASKABLE_ADDRESS);
 
 			TRACE_DEBUG_FORMAT(m_debug, "Cpu state", "\n%s", STRING_CHECK(as_string(true)));
@@ -2821,6 +3653,28 @@ namespace nescc {
 			return result;
 		}
 
+		void
+		cpu::invalidate_instructions(void)
+		{
+			TRACE_ENTRY();
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_CPU_EXCEPTION(NESCC_EMULATOR_CPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			if(!++m_instruction_generation) {
+				m_instruction_cache.assign(m_instruction_cache.size(), cpu_instruction_t());
+				m_instruction_generation = 1;
+			}
+
+			m_idle.length = 0;
+			m_idle.previous = nullptr;
+
+			TRACE_EXIT();
+		}
+
 		nescc::core::memory<uint8_t> &
 		cpu::oam_dma(void)
 		{
@@ -2882,7 +3736,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::pull_byte(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t result;
@@ -2897,7 +3751,7 @@ namespace nescc {
 
 		uint16_t
 		cpu::pull_word(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint16_t result = 0;
@@ -2913,7 +3767,7 @@ namespace nescc {
 
 		void
 		cpu::push_byte(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint8_t value
 			)
 		{
@@ -2926,7 +3780,7 @@ namespace nescc {
 
 		void
 		cpu::push_word(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint16_t value
 			)
 		{
@@ -2955,7 +3809,7 @@ namespace nescc {
 
 		uint8_t
 		cpu::read_byte(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint16_t address
 			)
 		{
@@ -2969,9 +3823,29 @@ namespace nescc {
 			return result;
 		}
 
+		template<uint8_t MODE> uint8_t
+		cpu::read_operand(
+			__in BUS_TYPE &bus,
+			__inout bool &boundary
+			)
+		{
+			uint8_t result;
+
+			TRACE_ENTRY_FORMAT("Bus=%p, Mode=%s", &bus, CPU_MODE_STRING(MODE));
+
+			if(MODE == CPU_MODE_IMMEDIATE) {
+				result = fetch_byte(bus);
+			} else {
+				result = read_byte(bus, address_operand<MODE>(bus, boundary));
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u(%02x)", result, result);
+			return result;
+		}
+
 		uint16_t
 		cpu::read_word(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint16_t address
 			)
 		{
@@ -2988,7 +3862,7 @@ namespace nescc {
 
 		void
 		cpu::reset(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in bool powerup,
 			__in_opt bool debug
 			)
@@ -3006,7 +3880,12 @@ namespace nescc {
 			m_cycle = 0;
 			m_debug = debug;
 			m_halt = false;
+			m_instruction = nullptr;
+			m_instruction_address = 0;
+			m_instruction_cache.assign(CPU_INSTRUCTION_CACHE_LENGTH, cpu_instruction_t());
+			m_instruction_generation = 1;
 			m_oam_dma.set_size(CPU_OAM_DMA_LENGTH);
+			m_oam_dma_stall = false;
 			m_program_counter = read_word(bus, CPU_INTERRUPT_RESET_ADDRESS);
 			m_ram.set_size(CPU_RAM_LENGTH);
 			m_signal_maskable = false;
@@ -3019,10 +3898,12 @@ namespace nescc {
 				m_index_y = 0;
 				m_stack_pointer = CPU_STACK_POINTER_ADDRESS_RESET;
 			} else {
-				m_flags |= CPU_FLAG_INTERRUPT_DISABLE;
+				m_flags = (flags_evaluate() | CPU_FLAG_INTERRUPT_DISABLE);
 				m_stack_pointer -= CPU_STACK_POINTER_ADDRESS_OFFSET;
 			}
 
+			m_flags_lazy = false;
+
 			bus.display_halt(false);
 
 			TRACE_DEBUG(m_debug, "Cpu reset");
@@ -3089,6 +3970,7 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_accumulator = value;
+			m_idle.length = 0;
 
 			TRACE_EXIT();
 		}
@@ -3107,13 +3989,15 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_flags = value;
+			m_flags_lazy = false;
+			m_idle.length = 0;
 
 			TRACE_EXIT();
 		}
 
 		void
 		cpu::set_halt(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in bool halt
 			)
 		{
@@ -3126,6 +4010,7 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_halt = halt;
+			m_idle.length = 0;
 			bus.display_halt(halt);
 
 			TRACE_EXIT();
@@ -3145,6 +4030,7 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_index_x = value;
+			m_idle.length = 0;
 
 			TRACE_EXIT();
 		}
@@ -3163,6 +4049,7 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_index_y = value;
+			m_idle.length = 0;
 
 			TRACE_EXIT();
 		}
@@ -3181,6 +4068,7 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_program_counter = value;
+			m_idle.length = 0;
 
 			TRACE_EXIT();
 		}
@@ -3199,6 +4087,7 @@ namespace nescc {
 #endif // NDEBUG
 
 			m_stack_pointer = value;
+			m_idle.length = 0;
 
 			TRACE_EXIT();
 		}
@@ -3252,138 +4141,47 @@ namespace nescc {
 
 		uint8_t
 		cpu::step(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
-			uint8_t result = 0;
-			std::pair<uint8_t, uint8_t> command;
+			uint8_t opcode, result = 0;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			command = CPU_COMMAND_MAP.at(read_byte(bus, m_program_counter));
+			m_instruction = nullptr;
+			m_instruction_address = m_program_counter;
 
-			TRACE_DEBUG_FORMAT(m_debug, "Cpu command", "[%04x] %s %s", m_program_counter,
-				CPU_COMMAND_STRING(command.first), CPU_MODE_STRING(command.second));
+#if CPU_INSTRUCTION_CACHE
+			if(!m_debug) {
+				m_instruction = fetch_instruction(bus);
+			}
+#endif // CPU_INSTRUCTION_CACHE
 
-			++m_program_counter;
+			opcode = fetch_byte(bus);
 
-			switch(command.first) {
-				case CPU_COMMAND_ADC:
-					result = execute_command_add(bus, command);
-					break;
-				case CPU_COMMAND_AND:
-					result = execute_command_and(bus, command);
-					break;
-				case CPU_COMMAND_ASL:
-					result = execute_command_shift_left(bus, command);
-					break;
-				case CPU_COMMAND_BCC:
-				case CPU_COMMAND_BCS:
-				case CPU_COMMAND_BEQ:
-				case CPU_COMMAND_BMI:
-				case CPU_COMMAND_BNE:
-				case CPU_COMMAND_BPL:
-				case CPU_COMMAND_BVC:
-				case CPU_COMMAND_BVS:
-					result = execute_command_branch(bus, command);
-					break;
-				case CPU_COMMAND_BIT:
-					result = execute_command_bit(bus, command);
-					break;
-				case CPU_COMMAND_BRK:
-					result = execute_command_break(bus, command);
-					break;
-				case CPU_COMMAND_CLC:
-				case CPU_COMMAND_CLD:
-				case CPU_COMMAND_CLI:
-				case CPU_COMMAND_CLV:
-				case CPU_COMMAND_SEC:
-				case CPU_COMMAND_SED:
-				case CPU_COMMAND_SEI:
-					result = execute_command_flag(command);
-					break;
-				case CPU_COMMAND_CMP:
-				case CPU_COMMAND_CPX:
-				case CPU_COMMAND_CPY:
-					result = execute_command_compare(bus, command);
-					break;
-				case CPU_COMMAND_DEC:
-				case CPU_COMMAND_DEX:
-				case CPU_COMMAND_DEY:
-					result = execute_command_decrement(bus, command);
-					break;
-				case CPU_COMMAND_EOR:
-					result = execute_command_or_exclusive(bus, command);
-					break;
-				case CPU_COMMAND_INC:
-				case CPU_COMMAND_INX:
-				case CPU_COMMAND_INY:
-					result = execute_command_increment(bus, command);
-					break;
-				case CPU_COMMAND_JMP:
-					result = execute_command_jump(bus, command);
-					break;
-				case CPU_COMMAND_JSR:
-					result = execute_command_subroutine(bus, command);
-					break;
-				case CPU_COMMAND_LDA:
-				case CPU_COMMAND_LDX:
-				case CPU_COMMAND_LDY:
-					result = execute_command_load(bus, command);
-					break;
-				case CPU_COMMAND_LSR:
-					result = execute_command_shift_right(bus, command);
-					break;
-				case CPU_COMMAND_NOP:
-					result = execute_command_nop(bus, command);
-					break;
-				case CPU_COMMAND_ORA:
-					result = execute_command_or(bus, command);
-					break;
-				case CPU_COMMAND_PHA:
-				case CPU_COMMAND_PHP:
-					result = execute_command_stack_push(bus, command);
-					break;
-				case CPU_COMMAND_PLA:
-				case CPU_COMMAND_PLP:
-					result = execute_command_stack_pull(bus, command);
-					break;
-				case CPU_COMMAND_ROL:
-					result = execute_command_rotate_left(bus, command);
-					break;
-				case CPU_COMMAND_ROR:
-					result = execute_command_rotate_right(bus, command);
-					break;
-				case CPU_COMMAND_RTI:
-					result = execute_command_return_interrupt(bus, command);
-					break;
-				case CPU_COMMAND_RTS:
-					result = execute_command_return(bus, command);
-					break;
-				case CPU_COMMAND_SBC:
-					result = execute_command_subtract(bus, command);
-					break;
-				case CPU_COMMAND_STA:
-				case CPU_COMMAND_STX:
-				case CPU_COMMAND_STY:
-					result = execute_command_store(bus, command);
-					break;
-				case CPU_COMMAND_TAX:
-				case CPU_COMMAND_TAY:
-				case CPU_COMMAND_TSX:
-				case CPU_COMMAND_TXA:
-				case CPU_COMMAND_TXS:
-				case CPU_COMMAND_TYA:
-					result = execute_command_transfer(command);
-					break;
-				default:
-					TRACE_MESSAGE_FORMAT(TRACE_WARNING, "Illegal command", "Address=%u(%04x), Command=%u(%02x)(%s), Mode=%u(%s)",
-						(m_program_counter - 1), (m_program_counter - 1),
-						command.first, command.first, CPU_COMMAND_STRING(command.first),
-						command.second, CPU_MODE_STRING(command.second));
-					result = execute_command_illegal(bus, command);
-					break;
-			}
+			TRACE_DEBUG_FORMAT(m_debug, "Cpu command", "[%04x] %s %s", m_instruction_address,
+				CPU_COMMAND_STRING(CPU_COMMAND_MAP[opcode].first), CPU_MODE_STRING(CPU_COMMAND_MAP[opcode].second));
+
+#if CPU_DISPATCH
+#if CPU_DISPATCH_LABEL
+			static void *const LABEL[] = {
+				CPU_OPCODE_LIST(CPU_DISPATCH_LABEL_ADDRESS)
+				};
+
+			goto *LABEL[opcode];
+			CPU_OPCODE_LIST(CPU_DISPATCH_LABEL_EXECUTE)
+
+cpu_opcode_exit:
+#else
+			static constexpr cpu_handler HANDLER[] = {
+				CPU_OPCODE_LIST(CPU_DISPATCH_HANDLER)
+				};
+
+			result = (this->*HANDLER[opcode])(bus);
+#endif // CPU_DISPATCH_LABEL
+#else
+			result = execute_command(bus, CPU_COMMAND_MAP[opcode]);
+#endif // CPU_DISPATCH
 
 			TRACE_DEBUG_FORMAT(m_debug, "Cpu state", "\n%s", STRING_CHECK(as_string(true)));
 
@@ -3391,6 +4189,37 @@ namespace nescc {
 			return result;
 		}
 
+		uint8_t
+		cpu::step_idle(
+			__in BUS_TYPE &bus
+			)
+		{
+			uint8_t result;
+
+			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+
+			// a ram poll is only run again once the polled value changes, a status poll always reads the port since
+			// the read has side-effects
+			if((m_idle.length > 1) && !m_idle.index && ((m_idle.type == CPU_IDLE_POLL_STATUS)
+					|| (m_ram.raw()[m_idle.watch] != m_idle.watch_value))) {
+				m_idle.length = 0;
+				result = step(bus);
+				idle_detect(result);
+			} else {
+				result = m_idle.cycles[m_idle.index];
+
+				if(++m_idle.index == m_idle.length) {
+					m_idle.index = 0;
+				}
+
+				m_program_counter = m_idle.address[m_idle.index];
+				m_idle.previous = nullptr;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
 		std::string
 		cpu::to_string(
 			__in_opt bool verbose
@@ -3423,10 +4252,10 @@ namespace nescc {
 
 					result << "}" << ", PC=" << m_program_counter << "(" << SCALAR_AS_HEX(uint16_t, m_program_counter) << ")"
 						<< ", SP=" << (int) m_stack_pointer << "(" << SCALAR_AS_HEX(uint8_t, m_stack_pointer) << ")"
-						<< ", P=" << (int) m_flags << "(" << SCALAR_AS_HEX(uint8_t, m_flags) << ") {";
+						<< ", P=" << (int) flags_evaluate() << "(" << SCALAR_AS_HEX(uint8_t, flags_evaluate()) << ") {";
 
 					for(int iter = CPU_FLAG_MAX; iter >= 0; iter--) {
-						result << " " << CPU_FLAG_STRING(iter) << "=" << ((m_flags & (1 << iter)) ? "1" : "0");
+						result << " " << CPU_FLAG_STRING(iter) << "=" << ((flags_evaluate() & (1 << iter)) ? "1" : "0");
 					}
 
 					result << " }, A=" << (int) m_accumulator << "(" << SCALAR_AS_HEX(uint8_t, m_accumulator) << ")"
@@ -3440,12 +4269,12 @@ namespace nescc {
 			return result.str();
 		}
 
-		uint8_t
+		uint16_t
 		cpu::update(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
-			uint8_t result = 0;
+			uint16_t result = 0;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
@@ -3469,9 +4298,60 @@ namespace nescc {
 					m_signal_maskable = false;
 				}
 
+#if CPU_IDLE
+				if(m_idle.length) {
+					result += step_idle(bus);
+				} else {
+					uint8_t cycles = step(bus);
+
+					idle_detect(cycles);
+					result += cycles;
+				}
+#else
 				result += step(bus);
+#endif // CPU_IDLE
+
+				if(m_oam_dma_stall) {
+					result += (CPU_CYCLES_OAM_DMA + ((m_cycle + result) & 1));
+					m_oam_dma_stall = false;
+				}
+
+				m_cycle += result;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
+		uint16_t
+		cpu::update_idle(
+			__in uint32_t limit
+			)
+		{
+			uint16_t result = 0;
+
+			TRACE_ENTRY_FORMAT("Limit=%u", limit);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_CPU_EXCEPTION(NESCC_EMULATOR_CPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+#if CPU_IDLE
+			if(m_idle.length && !m_idle.index) {
+				uint32_t iteration = 0;
+
+				for(uint8_t iter = 0; iter < m_idle.length; ++iter) {
+					iteration += m_idle.cycles[iter];
+				}
+
+				// whole loop iterations are skipped, so the next update starts the loop over from its first instruction
+				result = ((std::min(limit, (uint32_t) UINT16_MAX) / iteration) * iteration);
 				m_cycle += result;
+				m_idle.previous = nullptr;
 			}
+#endif // CPU_IDLE
 
 			TRACE_EXIT_FORMAT("Result=%u", result);
 			return result;
@@ -3479,7 +4359,7 @@ namespace nescc {
 
 		void
 		cpu::write_byte(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint16_t address,
 			__in uint8_t value
 			)
@@ -3493,27 +4373,24 @@ namespace nescc {
 
 		void
 		cpu::write_oam_dma(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint8_t bank
 			)
 		{
-			uint16_t base, iter;
-
 			TRACE_ENTRY_FORMAT("Bus=%p, Bank=%u(%02x)", &bus, bank, bank);
 
 			m_oam_dma.write(0, bank);
-			base = (m_oam_dma.read(0) * (UINT8_MAX + 1));
-
-			for(iter = 0; iter < PPU_OAM_LENGTH; ++iter) {
-				bus.ppu_write_oam(iter, bus.cpu_read(base + iter));
-			}
+			bus.ppu_write_oam_page(m_oam_dma.read(0) * (UINT8_MAX + 1));
+#if CPU_OAM_DMA_STALL
+			m_oam_dma_stall = true;
+#endif // CPU_OAM_DMA_STALL
 
 			TRACE_EXIT();
 		}
 
 		void
 		cpu::write_word(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint16_t address,
 			__in uint16_t value
 			)
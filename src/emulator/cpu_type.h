@@ -79,6 +79,7 @@ namespace nescc {
 				_FORMAT_, __VA_ARGS__)
 
 		#define CPU_CYCLES_BRANCH 1
+		#define CPU_CYCLES_OAM_DMA 513
 		#define CPU_CYCLES_PAGE_BOUNDARY 1
 		#define CPU_CYCLES_READ_WRITE 2
 
@@ -93,6 +94,21 @@ namespace nescc {
 
 		#define CPU_FLAG_RESET (CPU_FLAG_UNUSED | CPU_FLAG_BREAK | CPU_FLAG_INTERRUPT_DISABLE)
 
+#ifndef CPU_IDLE
+		#define CPU_IDLE CPU_INSTRUCTION_CACHE
+#endif // CPU_IDLE
+
+		#define CPU_IDLE_STATUS_END 0x3fff
+		#define CPU_IDLE_STATUS_START 0x2000
+
+#ifndef CPU_INSTRUCTION_CACHE
+		#define CPU_INSTRUCTION_CACHE 1
+#endif // CPU_INSTRUCTION_CACHE
+
+		#define CPU_INSTRUCTION_CACHE_START 0x8000
+		#define CPU_INSTRUCTION_CACHE_END (UINT16_MAX - (CPU_INSTRUCTION_LENGTH_MAX - 1))
+		#define CPU_INSTRUCTION_CACHE_LENGTH (CPU_INSTRUCTION_CACHE_END - CPU_INSTRUCTION_CACHE_START + 1)
+
 		#define CPU_INTERRUPT_MASKABLE_ADDRESS 0xfffe
 		#define CPU_INTERRUPT_NON_MASKABLE_ADDRESS 0xfffa
 		#define CPU_STACK_POINTER_ADDRESS_OFFSET 3
@@ -100,6 +116,10 @@ namespace nescc {
 
 		#define CPU_OAM_DMA_LENGTH 1
 
+#ifndef CPU_OAM_DMA_STALL
+		#define CPU_OAM_DMA_STALL 1
+#endif // CPU_OAM_DMA_STALL
+
 		#define CPU_STACK_POINTER_ADDRESS_BASE (UINT8_MAX + 1)
 		#define CPU_STACK_POINTER_ADDRESS_RESET (UINT8_MAX - 2)
 		#define CPU_STACK_POINTER_ADDRESS_MAX UINT8_MAX
@@ -147,7 +167,7 @@ namespace nescc {
 			(((_TYPE_) > CPU_MODE_MAX) ? STRING_UNKNOWN : \
 				STRING_CHECK(CPU_MODE_STR[_TYPE_]))
 
-		static const uint8_t CPU_MODE_CYC[] = {
+		static constexpr uint8_t CPU_MODE_CYC[] = {
 			4, 4, 4, 2, 2, 2, 5, 6, 5, 7, 6, 2, 4, 3, 3, 4, 4,
 			};
 
@@ -155,6 +175,10 @@ namespace nescc {
 			(((_TYPE_) > CPU_MODE_MAX) ? CPU_MODE_CYC[CPU_MODE_IMPLIED] : \
 				CPU_MODE_CYC[_TYPE_])
 
+		#define CPU_MODE_BOUNDARY_CYCLES(_TYPE_) \
+			((((_TYPE_) == CPU_MODE_ABSOLUTE_X) || ((_TYPE_) == CPU_MODE_ABSOLUTE_Y) \
+				|| ((_TYPE_) == CPU_MODE_INDIRECT_Y)) ? CPU_CYCLES_PAGE_BOUNDARY : 0)
+
 		static const uint8_t CPU_MODE_LEN[] = {
 			3, 3, 3, 1, 2, 1, 3, 2, 2, 1, 1, 2, 1, 1, 2, 2, 2,
 			};
@@ -209,7 +233,70 @@ namespace nescc {
 			(((_TYPE_) > CPU_COMMAND_MAX) ? STRING_UNKNOWN : \
 				STRING_CHECK(CPU_COMMAND_STR[_TYPE_]))
 
-		static const std::vector<std::pair<uint8_t, uint8_t>> CPU_COMMAND_MAP = {
+		#define CPU_COMMAND_ILLEGAL(_TYPE_) \
+			(((_TYPE_) >= CPU_COMMAND_ILLEGAL_AHX) && ((_TYPE_) <= CPU_COMMAND_MAX))
+
+		#define CPU_COMMAND_ATTRIBUTE_BOUNDARY 0x01
+		#define CPU_COMMAND_ATTRIBUTE_ZERO_SIGN 0x02
+
+		static constexpr uint8_t CPU_COMMAND_ATTR[] = {
+			3, 3, 2, 1, 1, 1, 0, 1, 1, 1,
+			0, 1, 1, 0, 0, 0, 0, 3, 3, 3,
+			3, 2, 2, 3, 3, 2, 2, 0, 0, 3,
+			3, 3, 2, 0, 3, 0, 0, 2, 0, 2,
+			2, 0, 0, 3, 0, 0, 0, 0, 0, 0,
+			2, 2, 2, 2, 0, 2,
+
+			// illegal instructions
+			0, 3, 3, 3, 3, 2, 2, 0, 3,
+			3, 1, 2, 2, 0, 3, 0, 0, 2,
+			2, 0, 3,
+			};
+
+		#define CPU_COMMAND_ATTRIBUTE(_TYPE_, _ATTRIBUTE_) \
+			(((_TYPE_) > CPU_COMMAND_MAX) ? false : \
+				((CPU_COMMAND_ATTR[_TYPE_] & (_ATTRIBUTE_)) == (_ATTRIBUTE_)))
+
+#ifndef CPU_DISPATCH
+		#define CPU_DISPATCH 1
+#endif // CPU_DISPATCH
+
+#ifndef CPU_FLAGS_LAZY
+		#define CPU_FLAGS_LAZY CPU_DISPATCH
+#endif // CPU_FLAGS_LAZY
+
+#ifdef __clang__
+		#define CPU_DISPATCH_LABEL 1
+#else
+		#define CPU_DISPATCH_LABEL 0
+#endif // __clang__
+
+		#define CPU_DISPATCH_HANDLER(_OPCODE_) \
+			&nescc::emulator::cpu::execute<_OPCODE_>,
+		#define CPU_DISPATCH_LABEL_ADDRESS(_OPCODE_) \
+			&&cpu_opcode_ ## _OPCODE_,
+		#define CPU_DISPATCH_LABEL_EXECUTE(_OPCODE_) \
+			cpu_opcode_ ## _OPCODE_: result = execute<_OPCODE_>(bus); goto cpu_opcode_exit;
+
+		typedef uint8_t (nescc::emulator::cpu::*cpu_handler)(
+			__in BUS_TYPE &bus
+			);
+
+		#define CPU_OPCODE_ROW(_MACRO_, _ROW_) \
+			_MACRO_(_ROW_ ## 0) _MACRO_(_ROW_ ## 1) _MACRO_(_ROW_ ## 2) _MACRO_(_ROW_ ## 3) \
+			_MACRO_(_ROW_ ## 4) _MACRO_(_ROW_ ## 5) _MACRO_(_ROW_ ## 6) _MACRO_(_ROW_ ## 7) \
+			_MACRO_(_ROW_ ## 8) _MACRO_(_ROW_ ## 9) _MACRO_(_ROW_ ## a) _MACRO_(_ROW_ ## b) \
+			_MACRO_(_ROW_ ## c) _MACRO_(_ROW_ ## d) _MACRO_(_ROW_ ## e) _MACRO_(_ROW_ ## f)
+
+		#define CPU_OPCODE_LIST(_MACRO_) \
+			CPU_OPCODE_ROW(_MACRO_, 0x0) CPU_OPCODE_ROW(_MACRO_, 0x1) CPU_OPCODE_ROW(_MACRO_, 0x2) \
+			CPU_OPCODE_ROW(_MACRO_, 0x3) CPU_OPCODE_ROW(_MACRO_, 0x4) CPU_OPCODE_ROW(_MACRO_, 0x5) \
+			CPU_OPCODE_ROW(_MACRO_, 0x6) CPU_OPCODE_ROW(_MACRO_, 0x7) CPU_OPCODE_ROW(_MACRO_, 0x8) \
+			CPU_OPCODE_ROW(_MACRO_, 0x9) CPU_OPCODE_ROW(_MACRO_, 0xa) CPU_OPCODE_ROW(_MACRO_, 0xb) \
+			CPU_OPCODE_ROW(_MACRO_, 0xc) CPU_OPCODE_ROW(_MACRO_, 0xd) CPU_OPCODE_ROW(_MACRO_, 0xe) \
+			CPU_OPCODE_ROW(_MACRO_, 0xf)
+
+		static constexpr std::pair<uint8_t, uint8_t> CPU_COMMAND_MAP[] = {
 			std::pair<uint8_t, uint8_t>(CPU_COMMAND_BRK, CPU_MODE_INTERRUPT), // 0x00
 			std::pair<uint8_t, uint8_t>(CPU_COMMAND_ORA, CPU_MODE_INDIRECT_X),
 			std::pair<uint8_t, uint8_t>(CPU_COMMAND_ILLEGAL_KIL, CPU_MODE_IMPLIED),
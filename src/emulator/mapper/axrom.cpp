@@ -27,6 +27,7 @@ namespace nescc {
 		namespace mapper {
 
 			axrom::axrom(void) :
+				m_port_select(),
 				m_ram_index(0),
 				m_rom_character_index(0),
 				m_rom_program_index_0(0),
@@ -86,7 +87,7 @@ namespace nescc {
 
 				TRACE_ENTRY_FORMAT("Cartridge=%p, Verbose=%x", &cartridge, verbose);
 
-				mirroring = cartridge.mirroring();
+				mirroring = this->mirroring(cartridge);
 				result << std::left << std::setw(COLUMN_WIDTH_LONG) << "Mirroring"
 						<< (int) mirroring << " (" << CARTRIDGE_MIRRORING_STRING(mirroring) << ")"
 					<< std::endl << std::left << std::setw(COLUMN_WIDTH_LONG) << "PRG RAM bank selected"
@@ -111,6 +112,7 @@ namespace nescc {
 			{
 				TRACE_ENTRY_FORMAT("Cartridge=%p", &cartridge);
 
+				m_port_select.raw = 0;
 				m_ram_index = 0;
 				m_rom_character_index = 0;
 				m_rom_program_index_0 = 0;
@@ -128,7 +130,7 @@ namespace nescc {
 
 				TRACE_ENTRY_FORMAT("Cartridge=%p", &cartridge);
 
-				result = cartridge.mirroring();
+				result = (m_port_select.select_vram ? CARTRIDGE_MIRRORING_SINGLE_UPPER : CARTRIDGE_MIRRORING_SINGLE_LOWER);
 
 				TRACE_EXIT_FORMAT("Result=%u(%02x)", result, result);
 				return result;
@@ -210,6 +212,7 @@ namespace nescc {
 			{
 				TRACE_ENTRY_FORMAT("Cartridge=%p", &cartridge);
 
+				m_port_select.raw = 0;
 				m_ram_index = 0;
 				m_rom_character_index = 0;
 				m_rom_program_index_0 = 0;
@@ -219,7 +222,7 @@ namespace nescc {
 				TRACE_MESSAGE_FORMAT(TRACE_INFORMATION, "|-PRG ROM Bank", "%u, %u", m_rom_program_index_0, m_rom_program_index_1);
 				TRACE_MESSAGE_FORMAT(TRACE_INFORMATION, "|-CHR ROM Bank", "%u", m_rom_character_index);
 				TRACE_MESSAGE_FORMAT(TRACE_INFORMATION, "|-PRG ROM Bank Data", "%u", m_port_select.select);
-				TRACE_MESSAGE_FORMAT(TRACE_INFORMATION, "|-Mirroring", "%u", cartridge.mirroring());
+				TRACE_MESSAGE_FORMAT(TRACE_INFORMATION, "|-Mirroring", "%u", mirroring(cartridge));
 
 				TRACE_EXIT();
 			}
@@ -323,7 +326,7 @@ namespace nescc {
 				TRACE_EXIT();
 			}
 
-			void
+			bool
 			axrom::write_rom_program(
 				__in nescc::emulator::interface::bus &bus,
 				__in nescc::emulator::cartridge &cartridge,
@@ -331,14 +334,19 @@ namespace nescc {
 				__in uint8_t value
 				)
 			{
+				bool result = false;
+
 				TRACE_ENTRY_FORMAT("Bus=%p, Cartridge=%p, Address=%u(%04x), Value=%u(%02x)", &bus, &cartridge,
 					address, address, value, value);
 
 				m_port_select.raw = value;
+				result = (m_rom_program_index_0 != (m_port_select.select * PRG_BANK_PER_PRG_ROM_BANK));
 				m_rom_program_index_0 = (m_port_select.select * PRG_BANK_PER_PRG_ROM_BANK);
 				m_rom_program_index_1 = (m_rom_program_index_0 + 1);
+				bus.ppu_set_mirroring(mirroring(cartridge));
 
-				TRACE_EXIT();
+				TRACE_EXIT_FORMAT("Result=%x", result);
+				return result;
 			}
 		}
 	}
@@ -325,7 +325,7 @@ namespace nescc {
 				TRACE_EXIT();
 			}
 
-			void
+			bool
 			cnrom::write_rom_program(
 				__in nescc::emulator::interface::bus &bus,
 				__in nescc::emulator::cartridge &cartridge,
@@ -333,13 +333,17 @@ namespace nescc {
 				__in uint8_t value
 				)
 			{
+				bool result = false;
+
 				TRACE_ENTRY_FORMAT("Bus=%p, Cartridge=%p, Address=%u(%04x), Value=%u(%02x)", &bus, &cartridge,
 					address, address, value, value);
 
 				m_port_select.raw = value;
+				result = (m_rom_character_index != m_port_select.select);
 				m_rom_character_index = m_port_select.select;
 
-				TRACE_EXIT();
+				TRACE_EXIT_FORMAT("Result=%x", result);
+				return result;
 			}
 		}
 	}
@@ -317,7 +317,7 @@ namespace nescc {
 				TRACE_EXIT();
 			}
 
-			void
+			bool
 			nrom::write_rom_program(
 				__in nescc::emulator::interface::bus &bus,
 				__in nescc::emulator::cartridge &cartridge,
@@ -325,6 +325,8 @@ namespace nescc {
 				__in uint8_t value
 				)
 			{
+				bool result = false;
+
 				TRACE_ENTRY_FORMAT("Bus=%p, Cartridge=%p, Address=%u(%04x), Value=%u(%02x)", &bus, &cartridge,
 					address, address, value, value);
 
@@ -341,7 +343,11 @@ namespace nescc {
 							"Address=%u(%04x)", address, address);
 				}
 
-				TRACE_EXIT();
+				// writes land in the mapped program rom itself
+				result = true;
+
+				TRACE_EXIT_FORMAT("Result=%x", result);
+				return result;
 			}
 		}
 	}
@@ -95,6 +95,12 @@ namespace nescc {
 				TRACE_ENTRY_FORMAT("Cartridge=%p, Verbose=%x", &cartridge, verbose);
 
 				switch(m_port_control.mirroring) {
+					case BANK_MIRRORING_ONE_SCREEN_LOWER:
+						mirroring = CARTRIDGE_MIRRORING_SINGLE_LOWER;
+						break;
+					case BANK_MIRRORING_ONE_SCREEN_UPPER:
+						mirroring = CARTRIDGE_MIRRORING_SINGLE_UPPER;
+						break;
 					case BANK_MIRRORING_VERTICAL:
 						mirroring = CARTRIDGE_MIRRORING_VERTICAL;
 						break;
@@ -293,6 +299,12 @@ namespace nescc {
 				}
 
 				switch(m_port_control.mirroring) {
+					case BANK_MIRRORING_ONE_SCREEN_LOWER:
+						bus.ppu_set_mirroring(CARTRIDGE_MIRRORING_SINGLE_LOWER);
+						break;
+					case BANK_MIRRORING_ONE_SCREEN_UPPER:
+						bus.ppu_set_mirroring(CARTRIDGE_MIRRORING_SINGLE_UPPER);
+						break;
 					case BANK_MIRRORING_VERTICAL:
 						bus.ppu_set_mirroring(CARTRIDGE_MIRRORING_VERTICAL);
 						break;
@@ -316,6 +328,12 @@ namespace nescc {
 				TRACE_ENTRY_FORMAT("Cartridge=%p", &cartridge);
 
 				switch(m_port_control.mirroring) {
+					case BANK_MIRRORING_ONE_SCREEN_LOWER:
+						result = CARTRIDGE_MIRRORING_SINGLE_LOWER;
+						break;
+					case BANK_MIRRORING_ONE_SCREEN_UPPER:
+						result = CARTRIDGE_MIRRORING_SINGLE_UPPER;
+						break;
 					case BANK_MIRRORING_VERTICAL:
 						result = CARTRIDGE_MIRRORING_VERTICAL;
 						break;
@@ -515,6 +533,12 @@ namespace nescc {
 					std::vector<nescc::emulator::mapper::port_sxrom_bank_character_t>::const_iterator iter_bank;
 
 					switch(m_port_control.mirroring) {
+						case BANK_MIRRORING_ONE_SCREEN_LOWER:
+							mirroring = CARTRIDGE_MIRRORING_SINGLE_LOWER;
+							break;
+						case BANK_MIRRORING_ONE_SCREEN_UPPER:
+							mirroring = CARTRIDGE_MIRRORING_SINGLE_UPPER;
+							break;
 						case BANK_MIRRORING_VERTICAL:
 							mirroring = CARTRIDGE_MIRRORING_VERTICAL;
 							break;
@@ -606,7 +630,7 @@ namespace nescc {
 				TRACE_EXIT();
 			}
 
-			void
+			bool
 			sxrom::write_rom_program(
 				__in nescc::emulator::interface::bus &bus,
 				__in nescc::emulator::cartridge &cartridge,
@@ -614,6 +638,8 @@ namespace nescc {
 				__in uint8_t value
 				)
 			{
+				bool result = false;
+
 				TRACE_ENTRY_FORMAT("Bus=%p, Cartridge=%p, Address=%u(%04x), Value=%u(%02x)", &bus, &cartridge,
 					address, address, value, value);
 
@@ -626,15 +652,19 @@ namespace nescc {
 
 						switch((address >> 13) & 3) {
 							case PORT_CONTROL: // 0x8000 - 0x9fff (internal)
+								result = (m_port_control.raw != m_port_shift);
 								m_port_control.raw = m_port_shift;
 								break;
 							case PORT_CHR_BANK_0: // 0xa000 - 0xbfff (internal)
+								result = (m_port_bank_character.at(CHR_BANK_0).raw != m_port_shift);
 								m_port_bank_character.at(CHR_BANK_0).raw = m_port_shift;
 								break;
 							case PORT_CHR_BANK_1: // 0xc000 - 0xdfff (internal)
+								result = (m_port_bank_character.at(CHR_BANK_1).raw != m_port_shift);
 								m_port_bank_character.at(CHR_BANK_1).raw = m_port_shift;
 								break;
 							case PORT_PRG_BANK: // 0xe000 - 0xffff (internal)
+								result = (m_port_bank_program.raw != m_port_shift);
 								m_port_bank_program.raw = m_port_shift;
 								break;
 							default:
@@ -648,14 +678,18 @@ namespace nescc {
 						find_banks(bus, cartridge);
 					}
 				} else {
+					uint8_t previous = m_port_control.raw;
+
 					m_port_shift = 0;
 					m_port_shift_latch = 0;
 					m_port_control.raw = 0;
 					m_port_control.prg_rom_mode = BANK_PRG_ROM_MODE_3;
+					result = (m_port_control.raw != previous);
 					find_banks(bus, cartridge);
 				}
 
-				TRACE_EXIT();
+				TRACE_EXIT_FORMAT("Result=%x", result);
+				return result;
 			}
 		}
 	}
@@ -673,7 +673,7 @@ namespace nescc {
 				TRACE_EXIT();
 			}
 
-			void
+			bool
 			txrom::write_rom_program(
 				__in nescc::emulator::interface::bus &bus,
 				__in nescc::emulator::cartridge &cartridge,
@@ -681,6 +681,9 @@ namespace nescc {
 				__in uint8_t value
 				)
 			{
+				bool result = false;
+				std::vector<std::pair<uint8_t, uint16_t>> character = m_rom_character_index, program = m_rom_program_index;
+
 				TRACE_ENTRY_FORMAT("Bus=%p, Cartridge=%p, Address=%u(%04x), Value=%u(%02x)", &bus, &cartridge,
 					address, address, value, value);
 
@@ -727,8 +730,10 @@ namespace nescc {
 				}
 
 				find_banks(bus, cartridge);
+				result = ((character != m_rom_character_index) || (program != m_rom_program_index));
 
-				TRACE_EXIT();
+				TRACE_EXIT_FORMAT("Result=%x", result);
+				return result;
 			}
 		}
 	}
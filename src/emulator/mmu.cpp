@@ -89,6 +89,21 @@ namespace nescc {
 			return result.str();
 		}
 
+		uint8_t
+		mmu::bank_rom_character(
+			__inout uint16_t &address
+			)
+		{
+			uint8_t result;
+
+			TRACE_ENTRY_FORMAT("Address=%u(%04x)", address, address);
+
+			result = mapper().rom_character(address);
+
+			TRACE_EXIT_FORMAT("Result=%u(%02x)", result, result);
+			return result;
+		}
+
 		nescc::emulator::cartridge &
 		mmu::cartridge(void)
 		{
@@ -144,12 +159,75 @@ namespace nescc {
 			}
 
 			m_debug = false;
+			m_tile.clear();
 
 			TRACE_MESSAGE(TRACE_INFORMATION, "Mmu cleared.");
 
 			TRACE_EXIT();
 		}
 
+		void
+		mmu::decode_tile(
+			__in uint8_t bank,
+			__in uint16_t address
+			)
+		{
+			uint8_t high, low, *row;
+
+			TRACE_ENTRY_FORMAT("Bank=%u, Address=%u(%04x)", bank, address, address);
+
+			address &= ~MMU_TILE_PLANE;
+			nescc::core::memory<uint8_t> &memory = m_cartridge.rom_character(bank);
+			low = memory.read(address);
+			high = memory.read(address + MMU_TILE_PLANE);
+			row = (m_tile.at(bank).raw() + MMU_TILE_OFFSET(address));
+
+			for(uint8_t iter = 0; iter < MMU_TILE_WIDTH; ++iter) {
+				uint8_t bit = ((MMU_TILE_WIDTH - 1) - iter);
+
+				row[iter] = ((((high >> bit) & 1) << 1) | ((low >> bit) & 1));
+			}
+
+			TRACE_EXIT();
+		}
+
+		nescc::emulator::interface::mapper &
+		mmu::mapper(void)
+		{
+			uint8_t type;
+			nescc::emulator::interface::mapper *result = nullptr;
+
+			TRACE_ENTRY();
+
+			type = m_cartridge.mapper();
+			switch(type) {
+				case CARTRIDGE_MAPPER_NROM:
+					result = &m_mapper_nrom;
+					break;
+				case CARTRIDGE_MAPPER_SXROM:
+					result = &m_mapper_sxrom;
+					break;
+				case CARTRIDGE_MAPPER_UXROM:
+					result = &m_mapper_uxrom;
+					break;
+				case CARTRIDGE_MAPPER_CNROM:
+					result = &m_mapper_cnrom;
+					break;
+				case CARTRIDGE_MAPPER_TXROM:
+					result = &m_mapper_txrom;
+					break;
+				case CARTRIDGE_MAPPER_AXROM:
+					result = &m_mapper_axrom;
+					break;
+				default:
+					THROW_NESCC_EMULATOR_MMU_EXCEPTION_FORMAT(NESCC_EMULATOR_MMU_EXCEPTION_UNSUPPORTED_TYPE,
+						"Type=%u", type);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return *result;
+		}
+
 		uint8_t
 		mmu::mirroring(void) const
 		{
@@ -224,6 +302,95 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		uint8_t *
+		mmu::page_ram(
+			__in uint16_t address,
+			__in uint16_t length
+			)
+		{
+			uint8_t bank, *result = nullptr;
+
+			TRACE_ENTRY_FORMAT("Address=%u(%04x), Length=%u(%04x)", address, address, length, length);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_MMU_EXCEPTION(NESCC_EMULATOR_MMU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			bank = mapper().ram(address);
+
+			if(bank < m_cartridge.ram_banks()) {
+				nescc::core::memory<uint8_t> &memory = m_cartridge.ram(bank);
+
+				if((address + length) <= memory.size()) {
+					result = (memory.raw() + address);
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
+		uint8_t *
+		mmu::page_rom_program(
+			__in uint16_t address,
+			__in uint16_t length
+			)
+		{
+			uint8_t bank, *result = nullptr;
+
+			TRACE_ENTRY_FORMAT("Address=%u(%04x), Length=%u(%04x)", address, address, length, length);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_MMU_EXCEPTION(NESCC_EMULATOR_MMU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			bank = mapper().rom_program(address);
+
+			if(bank < m_cartridge.rom_program_banks()) {
+				nescc::core::memory<uint8_t> &memory = m_cartridge.rom_program(bank);
+
+				if((address + length) <= memory.size()) {
+					result = (memory.raw() + address);
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
+		uint8_t *
+		mmu::page_tile(
+			__in uint16_t address,
+			__in uint16_t length
+			)
+		{
+			uint8_t bank, *result = nullptr;
+
+			TRACE_ENTRY_FORMAT("Address=%u(%04x), Length=%u(%04x)", address, address, length, length);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_MMU_EXCEPTION(NESCC_EMULATOR_MMU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			bank = bank_rom_character(address);
+			if(bank < m_tile.size()) {
+				nescc::core::memory<uint8_t> &memory = m_tile.at(bank);
+
+				if(((address + length) * MMU_TILE_SCALE) <= memory.size()) {
+					result = (memory.raw() + (address * MMU_TILE_SCALE));
+				}
+			}
+
+			TRACE_EXIT_FORMAT("Result=%p", result);
+			return result;
+		}
+
 		nescc::core::memory<uint8_t> &
 		mmu::ram(
 			__inout uint16_t &address
@@ -443,6 +610,21 @@ namespace nescc {
 			}
 
 			m_debug = debug;
+			m_tile.clear();
+
+			for(uint8_t bank = 0; bank < m_cartridge.rom_character_banks(); ++bank) {
+				uint32_t length = m_cartridge.rom_character(bank).size();
+
+				m_tile.push_back(nescc::core::memory<uint8_t>());
+				m_tile.back().set_size(length * MMU_TILE_SCALE);
+
+				for(uint32_t address = 0; address < length; address += MMU_TILE_LENGTH) {
+
+					for(uint8_t row = 0; row < MMU_TILE_PLANE; ++row) {
+						decode_tile(bank, address + row);
+					}
+				}
+			}
 
 			TRACE_DEBUG(m_debug, "Mmu reset");
 			TRACE_DEBUG_FORMAT(m_debug, "Mmu state", "\n%s", STRING_CHECK(as_string(true)));
@@ -682,7 +864,7 @@ namespace nescc {
 			__in uint8_t value
 			)
 		{
-			uint8_t type;
+			uint8_t bank, type;
 
 			TRACE_ENTRY_FORMAT("Address=%u(%04x), Value=%u(%02x)", address, address, value, value);
 
@@ -717,17 +899,23 @@ namespace nescc {
 						"Type=%u", type);
 			}
 
+			// keep the decoded tile row in step with character ram
+			bank = bank_rom_character(address);
+			if(bank < m_tile.size()) {
+				decode_tile(bank, address);
+			}
+
 			TRACE_EXIT();
 		}
 
-		void
+		bool
 		mmu::write_rom_program(
 			__in nescc::emulator::interface::bus &bus,
 			__in uint16_t address,
 			__in uint8_t value
 			)
 		{
-			uint8_t type;
+			bool result;
 
 			TRACE_ENTRY_FORMAT("Bus=%p, Address=%u(%04x), Value=%u(%02x)", &bus, address, address, value, value);
 
@@ -737,32 +925,10 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			type = m_cartridge.mapper();
-			switch(type) {
-				case CARTRIDGE_MAPPER_NROM:
-					m_mapper_nrom.write_rom_program(bus, m_cartridge, address, value);
-					break;
-				case CARTRIDGE_MAPPER_SXROM:
-					m_mapper_sxrom.write_rom_program(bus, m_cartridge, address, value);
-					break;
-				case CARTRIDGE_MAPPER_UXROM:
-					m_mapper_uxrom.write_rom_program(bus, m_cartridge, address, value);
-					break;
-				case CARTRIDGE_MAPPER_CNROM:
-					m_mapper_cnrom.write_rom_program(bus, m_cartridge, address, value);
-					break;
-				case CARTRIDGE_MAPPER_TXROM:
-					m_mapper_txrom.write_rom_program(bus, m_cartridge, address, value);
-					break;
-				case CARTRIDGE_MAPPER_AXROM:
-					m_mapper_axrom.write_rom_program(bus, m_cartridge, address, value);
-					break;
-				default:
-					THROW_NESCC_EMULATOR_MMU_EXCEPTION_FORMAT(NESCC_EMULATOR_MMU_EXCEPTION_UNSUPPORTED_TYPE,
-						"Type=%u", type);
-			}
+			result = mapper().write_rom_program(bus, m_cartridge, address, value);
 
-			TRACE_EXIT();
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
 		}
 	}
 }
@@ -16,12 +16,18 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
 #include "../../include/emulator/ppu.h"
+#include "../../include/emulator/bus.h"
 #include "../../include/emulator/cartridge.h"
 #include "../../include/core/bitmap.h"
 #include "../../include/trace.h"
 #include "./ppu_type.h"
 
+#if PPU_RENDER_SIMD && defined(__SSE2__)
+#include <immintrin.h>
+#endif // PPU_RENDER_SIMD && __SSE2__
+
 namespace nescc {
 
 	namespace emulator {
@@ -38,18 +44,29 @@ namespace nescc {
 			m_background_shift_high(0),
 			m_background_shift_low(0),
 			m_cycle(0),
+			m_cycle_event(0),
+			m_cycle_target(0),
 			m_debug(false),
 			m_dot(0),
 			m_fine_x(0),
 			m_frame_odd(false),
+			m_frame_skip(0),
+			m_frame_skip_count(0),
+			m_frame_skipped(false),
 			m_mirroring(0),
 			m_nametable_current(0),
+			m_nametable_slot(),
+			m_palette_cache(),
 			m_port_latch(false),
 			m_port_value(0),
 			m_port_value_buffer(0),
-			m_scanline(0)
+			m_scanline(0),
+			m_sprite_line()
 		{
 			TRACE_ENTRY();
+
+			generate_palette();
+
 			TRACE_EXIT();
 		}
 
@@ -237,22 +254,30 @@ namespace nescc {
 			m_background_shift_low = 0;
 			m_control.raw = 0;
 			m_cycle = 0;
+			m_cycle_event = 0;
+			m_cycle_target = 0;
 			m_debug = false;
 			m_dot = 0;
 			m_fine_x = 0;
 			m_frame_odd = false;
+			m_frame_skip = 0;
+			m_frame_skip_count = 0;
+			m_frame_skipped = false;
 			m_mask.raw = 0;
 			m_mirroring = 0;
 			m_nametable.clear();
 			m_nametable_current = 0;
+			std::memset(m_nametable_slot, 0, sizeof(m_nametable_slot));
 			m_oam.clear();
 			m_palette.clear();
+			std::memset(m_palette_cache, 0, sizeof(m_palette_cache));
 			m_port.clear();
 			m_port_latch = false;
 			m_port_value = 0;
 			m_port_value_buffer = 0;
 			m_scanline = 0;
 			m_sprite.clear();
+			std::memset(m_sprite_line, 0, PPU_SPRITE_LINE_LENGTH);
 			m_sprite_secondary.clear();
 			m_status.raw = 0;
 
@@ -328,14 +353,64 @@ namespace nescc {
 			return m_dot;
 		}
 
+		uint32_t
+		ppu::event_distance(
+			__in_opt bool status
+			) const
+		{
+			uint32_t position, result = UINT32_MAX;
+
+			TRACE_ENTRY_FORMAT("Status=%x", status);
+
+			position = PPU_DOT_POSITION(m_scanline, m_dot);
+
+			// a status poll waits on the vertical blank flag, which is set whether or not it signals an nmi
+			if(m_control.nmi || status) {
+				result = PPU_EVENT_DISTANCE(position, PPU_DOT_POSITION(PPU_SCANLINE_VBLANK_START, PPU_DOT_VBLANK));
+			}
+
+			if(m_mask.background || m_mask.sprite) {
+				uint32_t distance, scanline = m_scanline;
+
+				if(m_dot > PPU_DOT_MMU_INTERRUPT) {
+					++scanline;
+				}
+
+				switch(scanline) {
+					case PPU_SCANLINE_POST_RENDER ... (PPU_SCANLINE_PRE_RENDER - 1): // 240 - 260
+						scanline = PPU_SCANLINE_PRE_RENDER;
+						break;
+					case (PPU_SCANLINE_MAX + 1): // 262
+						scanline = PPU_SCANLINE_VISIBLE_START;
+						break;
+					default:
+						break;
+				}
+
+				distance = PPU_EVENT_DISTANCE(position, PPU_DOT_POSITION(scanline, PPU_DOT_MMU_INTERRUPT));
+				if(distance < result) {
+					result = distance;
+				}
+			}
+
+			// an event at distance n is reached after n + 1 updates, or after n updates if the odd frame dot
+			// is skipped along the way, so the shorter of the two is used
+			if(!result) {
+				result = 1;
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
 		void
 		ppu::execute_post_render(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
-			if(m_dot == PPU_DOT_POST_BEGIN) {
+			if((m_dot == PPU_DOT_POST_BEGIN) && !m_frame_skipped) {
 				bus.display_update();
 			}
 
@@ -344,7 +419,7 @@ namespace nescc {
 
 		void
 		ppu::execute_render(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in int type
 			)
 		{
@@ -369,7 +444,7 @@ namespace nescc {
 
 		void
 		ppu::execute_render_background(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in int type
 			)
 		{
@@ -460,9 +535,145 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		ppu::execute_render_scanline(
+			__in BUS_TYPE &bus
+			)
+		{
+			bool skip;
+			uint8_t attribute[PPU_RENDER_SCANLINE_TILE_MAX + 1], attribute_high, attribute_low,
+				background[PPU_RENDER_SCANLINE_WIDTH], background_high = 0, background_low = 0,
+				pixel[(PPU_RENDER_SCANLINE_TILE_MAX + 1) * PPU_TILE_WIDTH], tile;
+			uint16_t dot;
+
+			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+
+			// on a skipped frame no pixels are generated, so only the last two tiles are fetched, unless sprite 0 is
+			// on the scanline and could still hit
+			skip = (m_frame_skipped && !(m_mask.background && m_mask.sprite && !m_status.sprite_0_hit
+					&& !m_sprite.front().id));
+
+			// renders dots 0 - 257 of a visible scanline in one pass, leaving the ppu in the same state as the
+			// dot path would; tiles 0 and 1 were fetched into the shift registers during the previous scanline
+			clear_oam_secondary();
+			m_address = calculate_nametable_address();
+
+			attribute[1] = ((m_attribute_table_latch_high << 1) | m_attribute_table_latch_low);
+			attribute_high = m_attribute_table_shift_high;
+			attribute_low = m_attribute_table_shift_low;
+
+			for(dot = 0; dot < PPU_BLOCK_WIDTH; ++dot) {
+				uint8_t bit = ((PPU_BLOCK_WIDTH - 1) - dot);
+
+				pixel[dot] = ((((m_background_shift_high >> bit) & 1) << 1) | ((m_background_shift_low >> bit) & 1));
+			}
+
+			for(tile = 1; tile <= PPU_RENDER_SCANLINE_TILE_MAX; ++tile) {
+				const uint8_t *row;
+
+				if(skip && (tile < (PPU_RENDER_SCANLINE_TILE_MAX - 1))) {
+					update_scroll_horizontal();
+					m_address = calculate_nametable_address();
+					continue;
+				}
+
+				m_nametable_current = bus.ppu_read(m_address);
+				m_address = calculate_attribute_table_address();
+				m_attribute_table_current = bus.ppu_read(m_address);
+
+				if(m_address_vram.coarse_y & 2) {
+					m_attribute_table_current >>= 4;
+				}
+
+				if(m_address_vram.coarse_x & 2) {
+					m_attribute_table_current >>= 2;
+				}
+
+				m_address = calculate_background_address();
+
+				// tile rows are taken pre-decoded from the character tile cache, the last two tiles are still read
+				// since they are left in the shift registers at the end of the scanline
+				row = bus.ppu_read_tile(m_address);
+				if(!row || (tile >= (PPU_RENDER_SCANLINE_TILE_MAX - 1))) {
+					m_background_low = bus.ppu_read(m_address);
+					m_address += PPU_TILE_WIDTH;
+					m_background_high = bus.ppu_read(m_address);
+				} else {
+					m_address += PPU_TILE_WIDTH;
+				}
+
+				if(tile < PPU_RENDER_SCANLINE_TILE_MAX) {
+					uint8_t *entry = (pixel + ((tile + 1) * PPU_TILE_WIDTH));
+
+					update_scroll_horizontal();
+					m_address = calculate_nametable_address();
+					attribute[tile + 1] = (m_attribute_table_current & 3);
+
+					if(row) {
+						std::memcpy(entry, row, PPU_TILE_WIDTH);
+					} else {
+
+						for(dot = 0; dot < PPU_TILE_WIDTH; ++dot) {
+							uint8_t bit = ((PPU_TILE_WIDTH - 1) - dot);
+
+							entry[dot] = ((((m_background_high >> bit) & 1) << 1) | ((m_background_low >> bit) & 1));
+						}
+					}
+
+					if(tile == (PPU_RENDER_SCANLINE_TILE_MAX - 1)) {
+						background_high = m_background_high;
+						background_low = m_background_low;
+					}
+				} else {
+					update_scroll_vertical();
+				}
+			}
+
+			if(!skip) {
+
+				for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; ++dot) {
+					uint8_t &palette = background[dot];
+
+					palette = 0;
+
+					if(m_mask.background && !(!m_mask.background_left && (dot < PPU_TILE_WIDTH))) {
+						uint16_t position = (dot + m_fine_x);
+
+						palette = pixel[position];
+						if(palette) {
+
+							tile = (position / PPU_TILE_WIDTH);
+							if(tile) {
+								palette |= (attribute[tile] << 2);
+							} else {
+								uint8_t bit = ((PPU_TILE_WIDTH - 1) - position);
+
+								palette |= (((((attribute_high >> bit) & 1) << 1) | ((attribute_low >> bit) & 1))
+									<< 2);
+							}
+						}
+					}
+				}
+
+				generate_pixel_line(bus, background);
+			}
+
+			sprite_evaluate();
+			m_attribute_table_shift_high = ((attribute[PPU_RENDER_SCANLINE_TILE_MAX] & 2) ? UINT8_MAX : 0);
+			m_attribute_table_shift_low = ((attribute[PPU_RENDER_SCANLINE_TILE_MAX] & 1) ? UINT8_MAX : 0);
+			m_background_shift_high = (background_high << PPU_TILE_WIDTH);
+			m_background_shift_low = (background_low << PPU_TILE_WIDTH);
+			update_shift();
+			update_position_horizontal();
+			m_cycle += PPU_RENDER_SCANLINE_LENGTH;
+			m_dot = PPU_RENDER_SCANLINE_LENGTH;
+
+			TRACE_EXIT();
+		}
+
 		void
 		ppu::execute_render_sprite(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in int type
 			)
 		{
@@ -490,9 +701,52 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		ppu::generate_palette(void)
+		{
+			uint8_t table = 0;
+
+			TRACE_ENTRY();
+
+			// one color table per greyscale and emphasis combination, each set emphasis bit darkens the other two
+			// channels, so a channel is darkened (once) whenever an emphasis bit other than its own is set, even if its
+			// own bit is set too
+			for(; table < PPU_PALETTE_COLOR_TABLE_LENGTH; ++table) {
+				uint8_t emphasis = (table >> 1);
+
+				for(uint8_t value = 0; value < PPU_PALETTE_COLOR_LENGTH; ++value) {
+					nescc::core::pixel_t color;
+
+					color.raw = PPU_PALETTE_COLOR(value);
+					if(table & 1) {
+						uint8_t average = ((color.blue + color.green + color.red) / 3);
+						color.blue = average;
+						color.green = average;
+						color.red = average;
+					}
+
+					if(emphasis & ~1) {
+						color.red = PPU_PALETTE_COLOR_EMPHASIS(color.red);
+					}
+
+					if(emphasis & ~2) {
+						color.green = PPU_PALETTE_COLOR_EMPHASIS(color.green);
+					}
+
+					if(emphasis & ~4) {
+						color.blue = PPU_PALETTE_COLOR_EMPHASIS(color.blue);
+					}
+
+					m_palette_color[table][value] = color.raw;
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		void
 		ppu::generate_pixel(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			int dot = (m_dot - PPU_DOT_RENDER_PIXEL_LOW_MIN);
@@ -501,7 +755,6 @@ namespace nescc {
 
 			if((m_scanline < PPU_SCANLINE_POST_RENDER) && (dot >= 0) && (dot < PPU_DOT_SCROLL_VERTICAL)) {
 				bool priority = false;
-				nescc::core::pixel_t color;
 				uint8_t palette = 0, palette_object = 0;
 
 				generate_pixel_background(dot, palette);
@@ -515,15 +768,9 @@ namespace nescc {
 					palette = 0;
 				}
 
-				color.raw = PPU_PALETTE_COLOR(bus.ppu_read(PPU_PALETTE_TABLE_BASE + palette));
-				if(m_mask.greyscale) {
-					uint8_t average = ((color.blue + color.green + color.red) / 3);
-					color.blue = average;
-					color.green = average;
-					color.red = average;
+				if(!m_frame_skipped) {
+					bus.display_write(dot, m_scanline, m_palette_cache[palette]);
 				}
-
-				bus.display_write(dot, m_scanline, color.raw);
 			}
 
 			m_background_shift_high <<= 1;
@@ -555,6 +802,160 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		ppu::generate_pixel_line(
+			__in BUS_TYPE &bus,
+			__in const uint8_t *background
+			)
+		{
+			bool hit = false;
+			uint16_t dot;
+			uint32_t *line, line_local[PPU_RENDER_SCANLINE_WIDTH];
+			uint8_t index[PPU_RENDER_SCANLINE_WIDTH], sprite[PPU_RENDER_SCANLINE_WIDTH];
+
+			TRACE_ENTRY_FORMAT("Bus=%p, Background=%p", &bus, background);
+
+			// masked sprite dots are cleared up front, as is sprite 0 at the last dot, which never hits
+			if(m_mask.sprite) {
+				std::memcpy(sprite, m_sprite_line, PPU_RENDER_SCANLINE_WIDTH);
+
+				if(!m_mask.sprite_left) {
+					std::memset(sprite, 0, PPU_SPRITE_LENGTH);
+				}
+
+				sprite[PPU_DOT_RENDER_PIXEL_LOW_MAX] &= ~PPU_SPRITE_LINE_ZERO;
+			} else {
+				std::memset(sprite, 0, PPU_RENDER_SCANLINE_WIDTH);
+			}
+
+			// the sprite wins where it is opaque and either the background is transparent or the sprite is in front
+#if PPU_RENDER_SIMD && defined(__AVX2__)
+			__m256i mask_palette = _mm256_set1_epi8(PPU_SPRITE_LINE_PALETTE),
+				mask_priority = _mm256_set1_epi8(PPU_SPRITE_LINE_PRIORITY),
+				mask_zero = _mm256_set1_epi8(PPU_SPRITE_LINE_ZERO), zero = _mm256_setzero_si256();
+
+			for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; dot += PPU_RENDER_SIMD_WIDTH_AVX2) {
+				__m256i back = _mm256_loadu_si256((const __m256i *) &background[dot]),
+					object = _mm256_loadu_si256((const __m256i *) &sprite[dot]), back_clear, object_palette, select;
+
+				back_clear = _mm256_cmpeq_epi8(back, zero);
+				object_palette = _mm256_and_si256(object, mask_palette);
+				select = _mm256_andnot_si256(_mm256_cmpeq_epi8(object_palette, zero), _mm256_or_si256(back_clear,
+					_mm256_cmpeq_epi8(_mm256_and_si256(object, mask_priority), zero)));
+				_mm256_storeu_si256((__m256i *) &index[dot], _mm256_or_si256(_mm256_and_si256(select, object_palette),
+					_mm256_andnot_si256(select, back)));
+
+				if(_mm256_movemask_epi8(_mm256_andnot_si256(back_clear, _mm256_cmpeq_epi8(
+						_mm256_and_si256(object, mask_zero), mask_zero)))) {
+					hit = true;
+				}
+			}
+#elif PPU_RENDER_SIMD && defined(__SSE2__)
+			__m128i mask_palette = _mm_set1_epi8(PPU_SPRITE_LINE_PALETTE),
+				mask_priority = _mm_set1_epi8(PPU_SPRITE_LINE_PRIORITY),
+				mask_zero = _mm_set1_epi8(PPU_SPRITE_LINE_ZERO), zero = _mm_setzero_si128();
+
+			for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; dot += PPU_RENDER_SIMD_WIDTH_SSE2) {
+				__m128i back = _mm_loadu_si128((const __m128i *) &background[dot]),
+					object = _mm_loadu_si128((const __m128i *) &sprite[dot]), back_clear, object_palette, select;
+
+				back_clear = _mm_cmpeq_epi8(back, zero);
+				object_palette = _mm_and_si128(object, mask_palette);
+				select = _mm_andnot_si128(_mm_cmpeq_epi8(object_palette, zero), _mm_or_si128(back_clear,
+					_mm_cmpeq_epi8(_mm_and_si128(object, mask_priority), zero)));
+				_mm_storeu_si128((__m128i *) &index[dot], _mm_or_si128(_mm_and_si128(select, object_palette),
+					_mm_andnot_si128(select, back)));
+
+				if(_mm_movemask_epi8(_mm_andnot_si128(back_clear, _mm_cmpeq_epi8(_mm_and_si128(object, mask_zero),
+						mask_zero)))) {
+					hit = true;
+				}
+			}
+#else
+			for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; ++dot) {
+				uint8_t back = background[dot], object = sprite[dot], object_palette = (object & PPU_SPRITE_LINE_PALETTE);
+
+				if((object & PPU_SPRITE_LINE_ZERO) && back) {
+					hit = true;
+				}
+
+				index[dot] = ((object_palette && (!back || !(object & PPU_SPRITE_LINE_PRIORITY))) ? object_palette : back);
+			}
+#endif // PPU_RENDER_SIMD
+
+			if(hit) {
+				m_status.sprite_0_hit = 1;
+			}
+
+			// skipped frames never reach the framebuffer
+			if(!m_frame_skipped) {
+				line = bus.display_line(m_scanline);
+				if(!line) {
+					line = line_local;
+				}
+
+				// palette indices are mapped to colors straight into the framebuffer row
+#if PPU_RENDER_SIMD && defined(__AVX2__)
+				for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; dot += PPU_RENDER_SIMD_GATHER) {
+					_mm256_storeu_si256((__m256i *) &line[dot], _mm256_i32gather_epi32((const int *) m_palette_cache,
+						_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) &index[dot])), sizeof(uint32_t)));
+				}
+#elif PPU_RENDER_SIMD && defined(__SSSE3__)
+				__m128i channel_high[PPU_RENDER_SIMD_CHANNEL], channel_low[PPU_RENDER_SIMD_CHANNEL],
+					mask_high = _mm_set1_epi8(PPU_PALETTE_TABLE_OFFSET);
+				uint8_t channel[PPU_RENDER_SIMD_CHANNEL][PPU_PALETTE_LENGTH];
+
+				// the palette is split into one byte plane per channel, so each plane is a 32 entry shuffle table
+				for(dot = 0; dot < PPU_PALETTE_LENGTH; ++dot) {
+
+					for(uint8_t iter = 0; iter < PPU_RENDER_SIMD_CHANNEL; ++iter) {
+						channel[iter][dot] = ((m_palette_cache[dot] >> (iter * CHAR_BIT)) & UINT8_MAX);
+					}
+				}
+
+				for(uint8_t iter = 0; iter < PPU_RENDER_SIMD_CHANNEL; ++iter) {
+					channel_low[iter] = _mm_loadu_si128((const __m128i *) &channel[iter][0]);
+					channel_high[iter] = _mm_loadu_si128((const __m128i *) &channel[iter][PPU_PALETTE_TABLE_OFFSET]);
+				}
+
+				for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; dot += PPU_RENDER_SIMD_WIDTH_SSE2) {
+					__m128i blue_green, color[PPU_RENDER_SIMD_CHANNEL], red_alpha, select,
+						value = _mm_loadu_si128((const __m128i *) &index[dot]);
+
+					select = _mm_cmpeq_epi8(_mm_and_si128(value, mask_high), mask_high);
+
+					for(uint8_t iter = 0; iter < PPU_RENDER_SIMD_CHANNEL; ++iter) {
+						color[iter] = _mm_or_si128(_mm_andnot_si128(select, _mm_shuffle_epi8(channel_low[iter], value)),
+							_mm_and_si128(select, _mm_shuffle_epi8(channel_high[iter], value)));
+					}
+
+					blue_green = _mm_unpacklo_epi8(color[0], color[1]);
+					red_alpha = _mm_unpacklo_epi8(color[2], color[3]);
+					_mm_storeu_si128((__m128i *) &line[dot], _mm_unpacklo_epi16(blue_green, red_alpha));
+					_mm_storeu_si128((__m128i *) &line[dot + 4], _mm_unpackhi_epi16(blue_green, red_alpha));
+					blue_green = _mm_unpackhi_epi8(color[0], color[1]);
+					red_alpha = _mm_unpackhi_epi8(color[2], color[3]);
+					_mm_storeu_si128((__m128i *) &line[dot + 8], _mm_unpacklo_epi16(blue_green, red_alpha));
+					_mm_storeu_si128((__m128i *) &line[dot + 12], _mm_unpackhi_epi16(blue_green, red_alpha));
+				}
+#else
+				for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; ++dot) {
+					line[dot] = m_palette_cache[index[dot]];
+				}
+#endif // PPU_RENDER_SIMD
+
+				// a bus without a framebuffer row to hand out receives the row one pixel at a time
+				if(line == line_local) {
+
+					for(dot = 0; dot < PPU_RENDER_SCANLINE_WIDTH; ++dot) {
+						bus.display_write(dot, m_scanline, line[dot]);
+					}
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
 		void
 		ppu::generate_pixel_sprite(
 			__in int dot,
@@ -566,35 +967,16 @@ namespace nescc {
 			TRACE_ENTRY_FORMAT("Dot=%u, Palette=%u, Palette Object=%p, Priority=%p", dot, palette, &palette_object, &priority);
 
 			if(m_mask.sprite && !(!m_mask.sprite_left && (dot < PPU_SPRITE_LENGTH))) {
-				std::vector<nescc::emulator::sprite_t>::reverse_iterator entry;
-
-				for(entry = m_sprite.rbegin(); entry != m_sprite.rend(); ++entry) {
-
-					if((entry->id != PPU_SPRITE_ID_INVALID) && (entry->position_x <= dot)) {
-
-						int sprite_x = (dot - entry->position_x);
-						if(sprite_x < PPU_SPRITE_LENGTH) {
-							uint8_t palette_sprite;
-
-							if(entry->attributes & 0x40) {
-								sprite_x ^= (PPU_SPRITE_LENGTH - 1);
-							}
-
-							palette_sprite = ((((entry->data_high >> ((PPU_SPRITE_LENGTH - 1) - sprite_x)) & 1) << 1)
-										| ((entry->data_low >> ((PPU_SPRITE_LENGTH - 1) - sprite_x)) & 1));
+				uint8_t entry = m_sprite_line[dot];
 
-							if(palette_sprite) {
+				if(entry & PPU_SPRITE_LINE_PALETTE) {
 
-								if(!entry->id && palette && (dot != PPU_DOT_RENDER_PIXEL_LOW_MAX)) {
-									m_status.sprite_0_hit = 1;
-								}
-
-								palette_object = ((palette_sprite | ((entry->attributes & 3) << 2))
-											+ PPU_SPRITE_LENGTH_LONG);
-								priority = ((entry->attributes & 0x20) ? true : false);
-							}
-						}
+					if((entry & PPU_SPRITE_LINE_ZERO) && palette && (dot != PPU_DOT_RENDER_PIXEL_LOW_MAX)) {
+						m_status.sprite_0_hit = 1;
 					}
+
+					palette_object = (entry & PPU_SPRITE_LINE_PALETTE);
+					priority = ((entry & PPU_SPRITE_LINE_PRIORITY) ? true : false);
 				}
 			}
 
@@ -744,18 +1126,8 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			switch(m_mirroring) {
-				case CARTRIDGE_MIRRORING_HORIZONTAL:
-					address = (((address >> 1) & PPU_NAMETABLE_LENGTH) + (address % PPU_NAMETABLE_LENGTH));
-					break;
-				case CARTRIDGE_MIRRORING_VERTICAL:
-					address %= (PPU_NAMETABLE_LENGTH << 1);
-					break;
-				default:
-					break;
-			}
-
-			result = m_nametable.read(address);
+			address %= (PPU_NAMETABLE_LENGTH * PPU_NAMETABLE_COUNT);
+			result = m_nametable_slot[address / PPU_NAMETABLE_LENGTH][address % PPU_NAMETABLE_LENGTH];
 
 			TRACE_DEBUG_FORMAT(m_debug, "Ppu nametable read", "[%04x] -> %u(%02x)", address, result, result);
 
@@ -800,7 +1172,7 @@ namespace nescc {
 
 		uint8_t
 		ppu::read_port(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint8_t port
 			)
 		{
@@ -838,7 +1210,7 @@ namespace nescc {
 
 		uint8_t
 		ppu::read_port_data(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
@@ -886,7 +1258,7 @@ namespace nescc {
 
 		void
 		ppu::reset(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in_opt bool debug
 			)
 		{
@@ -914,14 +1286,19 @@ namespace nescc {
 			m_background_shift_low = 0;
 			m_control.raw = 0;
 			m_cycle = 0;
+			m_cycle_event = 0;
+			m_cycle_target = 0;
 			m_debug = debug;
 			m_dot = 0;
 			m_fine_x = 0;
 			m_frame_odd = false;
+			m_frame_skip_count = 0;
+			m_frame_skipped = false;
 			m_mask.raw = 0;
 			m_mirroring = bus.mirroring();
-			m_nametable.set_size(PPU_NAMETABLE_LENGTH * 2);
+			m_nametable.set_size(PPU_NAMETABLE_LENGTH * PPU_NAMETABLE_COUNT);
 			m_nametable_current = 0;
+			update_nametable();
 			m_oam.set_size(PPU_OAM_LENGTH);
 			m_palette.set_size(PPU_PALETTE_LENGTH);
 			m_port.set_size(PPU_PORT_MAX + 1);
@@ -930,6 +1307,7 @@ namespace nescc {
 			m_port_value_buffer = 0;
 			m_scanline = 0;
 			m_sprite.resize(PPU_SPRITE_LENGTH, PPU_SPRITE_INIT);
+			std::memset(m_sprite_line, 0, PPU_SPRITE_LINE_LENGTH);
 			m_sprite_secondary.resize(PPU_SPRITE_LENGTH, PPU_SPRITE_INIT);
 			m_status.raw = 0;
 			reset_palette();
@@ -971,6 +1349,54 @@ namespace nescc {
 			return m_scanline;
 		}
 
+		bool
+		ppu::schedule(
+			__in uint32_t cycles
+			)
+		{
+			bool result;
+
+			TRACE_ENTRY_FORMAT("Cycles=%u", cycles);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_PPU_EXCEPTION(NESCC_EMULATOR_PPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			m_cycle_target += cycles;
+			result = ((m_cycle_target - m_cycle) >= m_cycle_event);
+
+			TRACE_EXIT_FORMAT("Result=%x", result);
+			return result;
+		}
+
+		uint32_t
+		ppu::schedule_limit(
+			__in_opt bool status
+			) const
+		{
+			uint32_t event, owed, result = 0;
+
+			TRACE_ENTRY_FORMAT("Status=%x", status);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_PPU_EXCEPTION(NESCC_EMULATOR_PPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			// dots that can still be scheduled before schedule reports an event
+			event = (status ? event_distance(status) : m_cycle_event);
+			owed = (m_cycle_target - m_cycle);
+			if(owed < event) {
+				result = (event - owed - 1);
+			}
+
+			TRACE_EXIT_FORMAT("Result=%u", result);
+			return result;
+		}
+
 		uint8_t
 		ppu::scroll(void) const
 		{
@@ -1004,6 +1430,7 @@ namespace nescc {
 			TRACE_ENTRY_FORMAT("Value=%u(%02x)", value, value);
 
 			m_control = *((nescc::emulator::port_control_t *) &value);
+			m_cycle_event = event_distance();
 
 			TRACE_EXIT();
 		}
@@ -1020,6 +1447,27 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		ppu::set_frame_skip(
+			__in uint32_t skip
+			)
+		{
+			TRACE_ENTRY_FORMAT("Skip=%u", skip);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_PPU_EXCEPTION(NESCC_EMULATOR_PPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			// one of every skip frames is rendered, the others only keep their side effects
+			m_frame_skip = skip;
+			m_frame_skip_count = 0;
+			m_frame_skipped = false;
+
+			TRACE_EXIT();
+		}
+
 		void
 		ppu::set_mask(
 			__in uint8_t value
@@ -1028,6 +1476,8 @@ namespace nescc {
 			TRACE_ENTRY_FORMAT("Value=%u(%02x)", value, value);
 
 			m_mask = *((nescc::emulator::port_mask_t *) &value);
+			m_cycle_event = event_distance();
+			update_palette();
 
 			TRACE_EXIT();
 		}
@@ -1040,6 +1490,7 @@ namespace nescc {
 			TRACE_ENTRY_FORMAT("Value=%u(%02x)", value, value);
 
 			m_mirroring = value;
+			update_nametable();
 
 			TRACE_EXIT();
 		}
@@ -1123,15 +1574,17 @@ namespace nescc {
 
 		void
 		ppu::sprite_load(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			uint8_t iter = 0;
 			uint16_t address;
+			std::vector<nescc::emulator::sprite_t>::reverse_iterator entry;
 
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
 
 			for(; iter < PPU_SPRITE_LENGTH; ++iter) {
+				const uint8_t *row = nullptr;
 				uint8_t sprite_height, sprite_y;
 
 				m_sprite.at(iter) = m_sprite_secondary.at(iter);
@@ -1153,8 +1606,61 @@ namespace nescc {
 				}
 
 				address += ((sprite_y & 8) + sprite_y);
-				entry.data_low = bus.ppu_read(address);
-				entry.data_high = bus.ppu_read(address + PPU_SPRITE_LENGTH);
+
+				if(!m_debug) {
+					row = bus.ppu_read_tile(address);
+				}
+
+				if(row) {
+					std::memcpy(entry.data, row, PPU_SPRITE_ROW_LENGTH);
+				} else {
+					uint8_t data_high, data_low;
+
+					data_low = bus.ppu_read(address);
+					data_high = bus.ppu_read(address + PPU_SPRITE_LENGTH);
+
+					for(uint8_t sprite_x = 0; sprite_x < PPU_SPRITE_ROW_LENGTH; ++sprite_x) {
+						uint8_t bit = ((PPU_SPRITE_ROW_LENGTH - 1) - sprite_x);
+
+						entry.data[sprite_x] = ((((data_high >> bit) & 1) << 1) | ((data_low >> bit) & 1));
+					}
+				}
+			}
+
+			// composite the sprites of the next scanline back to front, so the lowest indexed opaque sprite wins
+			// each dot, while keeping track of where sprite 0 is opaque
+			std::memset(m_sprite_line, 0, PPU_SPRITE_LINE_LENGTH);
+
+			for(entry = m_sprite.rbegin(); entry != m_sprite.rend(); ++entry) {
+
+				if(entry->id != PPU_SPRITE_ID_INVALID) {
+
+					for(uint8_t sprite_x = 0; sprite_x < PPU_SPRITE_ROW_LENGTH; ++sprite_x) {
+						uint8_t palette_sprite;
+						uint16_t dot = (entry->position_x + sprite_x);
+
+						if(dot >= PPU_SPRITE_LINE_LENGTH) {
+							break;
+						}
+
+						palette_sprite = entry->data[(entry->attributes & 0x40) ? (sprite_x ^ (PPU_SPRITE_ROW_LENGTH - 1))
+								: sprite_x];
+						if(palette_sprite) {
+							uint8_t &line = m_sprite_line[dot];
+
+							line = ((line & PPU_SPRITE_LINE_ZERO) | ((palette_sprite | ((entry->attributes & 3) << 2))
+									+ PPU_SPRITE_LENGTH_LONG));
+
+							if(entry->attributes & 0x20) {
+								line |= PPU_SPRITE_LINE_PRIORITY;
+							}
+
+							if(!entry->id) {
+								line |= PPU_SPRITE_LINE_ZERO;
+							}
+						}
+					}
+				}
 			}
 
 			TRACE_EXIT();
@@ -1173,6 +1679,38 @@ namespace nescc {
 			return result;
 		}
 
+		void
+		ppu::synchronize(
+			__in BUS_TYPE &bus
+			)
+		{
+			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_PPU_EXCEPTION(NESCC_EMULATOR_PPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			while(m_cycle != m_cycle_target) {
+
+#if PPU_RENDER_SCANLINE
+				// whole visible scanlines that no cpu access interrupts are rendered in one pass
+				if(!m_debug && !m_dot && (m_scanline <= PPU_SCANLINE_VISIBLE_END)
+						&& ((m_cycle_target - m_cycle) >= PPU_RENDER_SCANLINE_LENGTH)) {
+					execute_render_scanline(bus);
+					continue;
+				}
+#endif // PPU_RENDER_SCANLINE
+
+				update(bus);
+			}
+
+			m_cycle_event = event_distance();
+
+			TRACE_EXIT();
+		}
+
 		std::string
 		ppu::to_string(
 			__in_opt bool verbose
@@ -1225,7 +1763,7 @@ namespace nescc {
 
 		void
 		ppu::update(
-			__in nescc::emulator::interface::bus &bus
+			__in BUS_TYPE &bus
 			)
 		{
 			TRACE_ENTRY_FORMAT("Bus=%p", &bus);
@@ -1274,6 +1812,12 @@ namespace nescc {
 				if(++m_scanline > PPU_SCANLINE_MAX) {
 					m_scanline = 0;
 					m_frame_odd = !m_frame_odd;
+
+					if(++m_frame_skip_count >= m_frame_skip) {
+						m_frame_skip_count = 0;
+					}
+
+					m_frame_skipped = (m_frame_skip_count != 0);
 				}
 			}
 
@@ -1284,6 +1828,50 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		ppu::update_nametable(void)
+		{
+			uint8_t iter = 0, mirroring = m_mirroring;
+
+			TRACE_ENTRY();
+
+			if(mirroring > CARTRIDGE_MIRRORING_MAX) {
+				mirroring = CARTRIDGE_MIRRORING_FOUR_SCREEN;
+			}
+
+			// the four logical nametables are pointed at their physical 1KB slot, so accesses need no mirroring logic
+			if(m_nametable.size()) {
+
+				for(; iter < PPU_NAMETABLE_COUNT; ++iter) {
+					m_nametable_slot[iter] = (m_nametable.raw()
+						+ (PPU_NAMETABLE_SLOT[mirroring][iter] * PPU_NAMETABLE_LENGTH));
+				}
+			}
+
+			TRACE_EXIT();
+		}
+
+		void
+		ppu::update_palette(void)
+		{
+			uint16_t address = 0;
+			const uint32_t *color = m_palette_color[PPU_PALETTE_COLOR_TABLE(m_mask.raw)];
+
+			TRACE_ENTRY();
+
+			for(; address < PPU_PALETTE_LENGTH; ++address) {
+				uint16_t offset = address;
+
+				if((address >= PPU_PALETTE_TABLE_OFFSET) && !(address % 4)) {
+					offset -= PPU_PALETTE_TABLE_OFFSET;
+				}
+
+				m_palette_cache[address] = color[PPU_PALETTE_COLOR_VALUE(m_palette.read(offset))];
+			}
+
+			TRACE_EXIT();
+		}
+
 		void
 		ppu::update_position_horizontal(void)
 		{
@@ -1378,18 +1966,8 @@ namespace nescc {
 			}
 #endif // NDEBUG
 
-			switch(m_mirroring) {
-				case CARTRIDGE_MIRRORING_HORIZONTAL:
-					address = (((address >> 1) & PPU_NAMETABLE_LENGTH) + (address % PPU_NAMETABLE_LENGTH));
-					break;
-				case CARTRIDGE_MIRRORING_VERTICAL:
-					address %= (PPU_NAMETABLE_LENGTH << 1);
-					break;
-				default:
-					break;
-			}
-
-			m_nametable.write(address, value);
+			address %= (PPU_NAMETABLE_LENGTH * PPU_NAMETABLE_COUNT);
+			m_nametable_slot[address / PPU_NAMETABLE_LENGTH][address % PPU_NAMETABLE_LENGTH] = value;
 
 			TRACE_DEBUG_FORMAT(m_debug, "Ppu nametable write", "[%04x] <- %u(%02x)", address, value, value);
 
@@ -1417,6 +1995,34 @@ namespace nescc {
 			TRACE_EXIT();
 		}
 
+		void
+		ppu::write_oam_page(
+			__in const uint8_t *data
+			)
+		{
+			uint8_t address, *oam;
+
+			TRACE_ENTRY_FORMAT("Data=%p", data);
+
+#ifndef NDEBUG
+			if(!m_initialized) {
+				THROW_NESCC_EMULATOR_PPU_EXCEPTION(NESCC_EMULATOR_PPU_EXCEPTION_UNINITIALIZED);
+			}
+#endif // NDEBUG
+
+			// equivalent to PPU_OAM_LENGTH data port writes: the copy wraps around at the oam address, which ends
+			// where it started
+			address = m_port.read(PPU_PORT_OAM_ADDRESS);
+			oam = m_oam.raw();
+			std::memcpy(oam + address, data, PPU_OAM_LENGTH - address);
+			std::memcpy(oam, data + (PPU_OAM_LENGTH - address), address);
+			m_port.write(PPU_PORT_OAM_DATA, data[PPU_OAM_LENGTH - 1]);
+
+			TRACE_DEBUG_FORMAT(m_debug, "Ppu oam page write", "[%04x] <- %p", address, data);
+
+			TRACE_EXIT();
+		}
+
 		void
 		ppu::write_palette(
 			__in uint16_t address,
@@ -1444,6 +2050,11 @@ namespace nescc {
 			}
 
 			m_palette.write(address, value);
+			m_palette_cache[address] = m_palette_color[PPU_PALETTE_COLOR_TABLE(m_mask.raw)][PPU_PALETTE_COLOR_VALUE(value)];
+
+			if(!(address % 4)) {
+				m_palette_cache[address + PPU_PALETTE_TABLE_OFFSET] = m_palette_cache[address];
+			}
 
 			TRACE_DEBUG_FORMAT(m_debug, "Ppu palette write", "[%04x] <- %u(%02x)", address, value, value);
 
@@ -1452,7 +2063,7 @@ namespace nescc {
 
 		void
 		ppu::write_port(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint8_t port,
 			__in uint8_t value
 			)
@@ -1531,13 +2142,14 @@ namespace nescc {
 			m_control.raw = value;
 			m_address_temp.nametable = m_control.nametable;
 			m_port.write(PPU_PORT_CONTROL, value);
+			m_cycle_event = event_distance();
 
 			TRACE_EXIT();
 		}
 
 		void
 		ppu::write_port_data(
-			__in nescc::emulator::interface::bus &bus,
+			__in BUS_TYPE &bus,
 			__in uint8_t value
 			)
 		{
@@ -1557,8 +2169,15 @@ namespace nescc {
 		{
 			TRACE_ENTRY_FORMAT("Value=%u(%02x)", value, value);
 
-			m_mask.raw = value;
+			if((m_mask.raw ^ value) & PPU_PALETTE_COLOR_MASK) {
+				m_mask.raw = value;
+				update_palette();
+			} else {
+				m_mask.raw = value;
+			}
+
 			m_port.write(PPU_PORT_MASK, value);
+			m_cycle_event = event_distance();
 
 			TRACE_EXIT();
 		}
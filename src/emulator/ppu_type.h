@@ -63,6 +63,8 @@ namespace nescc {
 		#define PPU_DATA_ADDRESS_MAX 0x3eff
 
 		#define PPU_DOT_MAX 340
+		#define PPU_DOT_POSITION(_SCANLINE_, _DOT_) (((_SCANLINE_) * (PPU_DOT_MAX + 1)) + (_DOT_))
+		#define PPU_DOTS_PER_FRAME PPU_DOT_POSITION(PPU_SCANLINE_MAX + 1, 0)
 		#define PPU_DOT_CLEAR_OAM 1 // 261, 1
 		#define PPU_DOT_MMU_INTERRUPT 260
 		#define PPU_DOT_NAMETABLE_READ_HIGH 340
@@ -83,8 +85,19 @@ namespace nescc {
 		#define PPU_DOT_VBLANK 1 // 241, 1
 		#define PPU_DOT_VBLANK_CLEAR 1 // 261, 1
 
+		#define PPU_EVENT_DISTANCE(_POSITION_, _EVENT_) \
+			((((_EVENT_) + PPU_DOTS_PER_FRAME) - (_POSITION_)) % PPU_DOTS_PER_FRAME)
+
 		#define PPU_NAMETABLE_BASE 0x2000
 
+		static const uint8_t PPU_NAMETABLE_SLOT[][PPU_NAMETABLE_COUNT] = {
+			{ 0, 0, 1, 1, }, // horizontal
+			{ 0, 1, 0, 1, }, // vertical
+			{ 0, 0, 0, 0, }, // single-screen (lower)
+			{ 1, 1, 1, 1, }, // single-screen (upper)
+			{ 0, 1, 2, 3, }, // four-screen
+			};
+
 		#define PPU_PALETTE_TABLE_BASE 0x3f00
 		#define PPU_PALETTE_TABLE_INIT 0x3f
 		#define PPU_PALETTE_TABLE_OFFSET 0x10
@@ -101,6 +114,11 @@ namespace nescc {
 		#define PPU_SPRITE_LENGTH 8
 		#define PPU_SPRITE_LENGTH_LONG 16
 
+		// per-scanline sprite line buffer entries
+		#define PPU_SPRITE_LINE_PALETTE 0x1f // composited sprite palette index (0 = transparent)
+		#define PPU_SPRITE_LINE_PRIORITY 0x20 // sprite is behind the background
+		#define PPU_SPRITE_LINE_ZERO 0x40 // sprite 0 is opaque
+
 		#define PPU_TILE_WIDTH 8
 
 		static const uint32_t PPU_PALETTE_COL[] = {
@@ -120,6 +138,17 @@ namespace nescc {
 			(((_IDX_) > PPU_PALETTE_COL_MAX) ? 0 : \
 				PPU_PALETTE_COL[_IDX_])
 
+		#define PPU_PALETTE_COLOR_EMPHASIS(_CHANNEL_) \
+			(((_CHANNEL_) * 3) / 4)
+
+		#define PPU_PALETTE_COLOR_MASK 0xe1 // greyscale and emphasis bits
+
+		#define PPU_PALETTE_COLOR_TABLE(_MASK_) \
+			((((_MASK_) >> 4) & 0x0e) | ((_MASK_) & 1))
+
+		#define PPU_PALETTE_COLOR_VALUE(_VALUE_) \
+			((_VALUE_) & (PPU_PALETTE_COLOR_LENGTH - 1))
+
 		static const std::string PPU_PORT_STR[] = {
 			"Control", "Mask", "Status", "OAM Address", "OAM Data", "Scroll",
 			"Address", "Data",
@@ -159,6 +188,23 @@ namespace nescc {
 
 		#define PPU_RENDER_PIXEL_MAX PPU_RENDER_PIXEL_BACKGROUND_HIGH_CALCULATE
 
+#ifndef PPU_RENDER_SCANLINE
+		#define PPU_RENDER_SCANLINE 1
+#endif // PPU_RENDER_SCANLINE
+
+		#define PPU_RENDER_SCANLINE_LENGTH (PPU_DOT_POSITION_UPDATE_HORIZONTAL + 1) // 0 - 257
+		#define PPU_RENDER_SCANLINE_TILE_MAX 32
+		#define PPU_RENDER_SCANLINE_WIDTH 256
+
+#ifndef PPU_RENDER_SIMD
+		#define PPU_RENDER_SIMD 1
+#endif // PPU_RENDER_SIMD
+
+		#define PPU_RENDER_SIMD_CHANNEL 4 // blue, green, red, alpha
+		#define PPU_RENDER_SIMD_GATHER 8 // pixels per avx2 gather
+		#define PPU_RENDER_SIMD_WIDTH_AVX2 32
+		#define PPU_RENDER_SIMD_WIDTH_SSE2 16
+
 		enum {
 			PPU_SPRITE_POSITION_Y = 0,
 			PPU_SPRITE_TILE_ID,
@@ -172,8 +218,7 @@ namespace nescc {
 			.position_y = 0xff,
 			.tile = 0xff,
 			.attributes = 0xff,
-			.data_low = 0,
-			.data_high = 0
+			.data = {}
 			};
 	}
 }
@@ -27,6 +27,11 @@ namespace nescc {
 		m_debug(false),
 		m_display(nescc::display::acquire()),
 		m_frame(1),
+		m_frame_skip(0),
+		m_frame_skip_pending(false),
+		m_headless(false),
+		m_low_power(false),
+		m_scale(POST_PROCESS_SCALE_DEFAULT),
 		m_step(false),
 		m_step_frame(false),
 		m_trace(nescc::trace::acquire())
@@ -142,6 +147,7 @@ namespace nescc {
 
 			result = poll_events();
 			if(result) {
+				update_frame_skip();
 				m_bus.step(cycle);
 			}
 
@@ -151,12 +157,14 @@ namespace nescc {
 
 			result = poll_events();
 			if(result) {
+				update_frame_skip();
 				m_bus.update(cycle);
 				++m_frame;
 			}
 
+			// the stepped frame was already presented at its end, so it is only redrawn here, not filtered again
 			m_step_complete.notify();
-			m_display.update();
+			m_display.update(true);
 		} else {
 			uint32_t frame = 0, start = SDL_GetTicks();
 
@@ -184,12 +192,13 @@ namespace nescc {
 						break;
 					}
 
+					update_frame_skip();
 					m_bus.update(cycle);
 					++m_frame;
 					++frame;
 
 					delta = (SDL_GetTicks() - end);
-					if(delta < RUNTIME_FRAME_DELTA) {
+					if(!m_headless && (delta < RUNTIME_FRAME_DELTA)) {
 						SDL_Delay(RUNTIME_FRAME_DELTA - delta);
 					}
 				} else {
@@ -224,11 +233,26 @@ namespace nescc {
 		TRACE_MESSAGE(TRACE_INFORMATION, "Runtime starting...");
 
 		try {
+
+			if(!m_headless) {
+				TRACE_MESSAGE(TRACE_INFORMATION, "SDL video initializing...");
+
+				if(SDL_InitSubSystem(RUNTIME_SDL_FLAGS_VIDEO)) {
+					THROW_NESCC_RUNTIME_EXCEPTION_FORMAT(NESCC_RUNTIME_EXCEPTION_EXTERNAL,
+						"SDL_InitSubSystem failed! Error=%s", SDL_GetError());
+				}
+
+				TRACE_MESSAGE(TRACE_INFORMATION, "SDL video initialized.");
+			}
+
+			m_display.set_headless(m_headless);
 			m_display.initialize();
 			m_display.reset(m_debug);
 			m_display.set_icon(RUNTIME_ICON_PATH);
 			m_display.set_title(m_path);
 			m_display.set_filter_crt(m_crt_filter);
+			m_display.set_low_power(m_low_power);
+			m_display.set_scale(m_scale);
 			m_bus.load(m_path, m_debug);
 			m_bus.reset(m_debug);
 			m_step_complete.clear();
@@ -256,6 +280,12 @@ namespace nescc {
 		m_bus.uninitialize();
 		m_display.uninitialize();
 
+		if(SDL_WasInit(RUNTIME_SDL_FLAGS_VIDEO)) {
+			TRACE_MESSAGE(TRACE_INFORMATION, "SDL video uninitializing...");
+			SDL_QuitSubSystem(RUNTIME_SDL_FLAGS_VIDEO);
+			TRACE_MESSAGE(TRACE_INFORMATION, "SDL video uninitialized.");
+		}
+
 		TRACE_MESSAGE(TRACE_INFORMATION, "Runtime stopped.");
 
 		TRACE_EXIT();
@@ -277,6 +307,11 @@ namespace nescc {
 		m_crt_filter = false;
 		m_debug = false;
 		m_frame = 1;
+		m_frame_skip = 0;
+		m_frame_skip_pending = false;
+		m_headless = false;
+		m_low_power = false;
+		m_scale = POST_PROCESS_SCALE_DEFAULT;
 		m_step = false;
 		m_step_frame = false;
 
@@ -328,7 +363,13 @@ namespace nescc {
 
 		TRACE_ENTRY();
 
-		while(SDL_PollEvent(&event)) {
+		// the presenter pumps the window's events on its own thread, so they are only drained here, unless there is
+		// no window to present
+		if(m_headless) {
+			SDL_PumpEvents();
+		}
+
+		while(SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0) {
 
 			switch(event.type) {
 				case SDL_CONTROLLERBUTTONDOWN:
@@ -386,11 +427,16 @@ namespace nescc {
 		__in_opt bool debug,
 		__in_opt bool step,
 		__in_opt bool step_frame,
-		__in_opt bool crt_filter
+		__in_opt bool crt_filter,
+		__in_opt bool headless,
+		__in_opt bool low_power,
+		__in_opt uint32_t frame_skip,
+		__in_opt uint32_t scale
 		)
 	{
-		TRACE_ENTRY_FORMAT("Path[%u]=%s, Debug=%x, Step=%x, Step-frame=%x, Crt-filter=%x", path.size(), STRING_CHECK(path), debug,
-			step, step_frame, crt_filter);
+		TRACE_ENTRY_FORMAT("Path[%u]=%s, Debug=%x, Step=%x, Step-frame=%x, Crt-filter=%x, Headless=%x, Low-power=%x, "
+			"Frame-skip=%u, Scale=%u", path.size(), STRING_CHECK(path), debug, step, step_frame, crt_filter, headless,
+			low_power, frame_skip, scale);
 
 #ifndef NDEBUG
 		if(!m_initialized) {
@@ -400,8 +446,13 @@ namespace nescc {
 
 		m_crt_filter = crt_filter;
 		m_frame = 1;
+		m_frame_skip = frame_skip;
+		m_frame_skip_pending = true;
+		m_headless = headless;
+		m_low_power = low_power;
 		m_path = path;
 		m_debug = debug;
+		m_scale = scale;
 		m_step = step;
 		m_step_frame = step_frame;
 		nescc::core::thread::start(!step && !step_frame);
@@ -428,6 +479,26 @@ namespace nescc {
 		return result;
 	}
 
+	void
+	runtime::set_frame_skip(
+		__in uint32_t skip
+		)
+	{
+		TRACE_ENTRY_FORMAT("Skip=%u", skip);
+
+#ifndef NDEBUG
+		if(!m_initialized) {
+			THROW_NESCC_RUNTIME_EXCEPTION(NESCC_RUNTIME_EXCEPTION_UNINITIALIZED);
+		}
+#endif // NDEBUG
+
+		// the ppu is only touched from the runtime thread, so the value is queued and applied at the next frame boundary
+		m_frame_skip = skip;
+		m_frame_skip_pending = true;
+
+		TRACE_EXIT();
+	}
+
 	void
 	runtime::step(void)
 	{
@@ -497,8 +568,12 @@ namespace nescc {
 				result << ", Mode=" << (m_debug ? "Debug" : "Normal")
 						<< "/" << (m_step ? "Stepped" : (m_step_frame ? "Stepped-frame" : "Freerunning"))
 						<< "/" << (m_crt_filter ? "CRT-filter" : "Unfiltered")
+						<< "/" << (m_headless ? "Headless" : "Windowed")
+						<< "/" << (m_low_power ? "Low-power" : "Full-power")
 					<< ", Path[" << m_path.size() << "]=" << m_path
-					<< ", Frame=" << m_frame;
+					<< ", Frame=" << m_frame
+					<< ", Frame-skip=" << m_frame_skip
+					<< ", Scale=" << m_scale;
 			}
 		}
 
@@ -522,6 +597,18 @@ namespace nescc {
 		TRACE_EXIT();
 	}
 
+	void
+	runtime::update_frame_skip(void)
+	{
+		TRACE_ENTRY();
+
+		if(m_frame_skip_pending.exchange(false)) {
+			m_bus.set_frame_skip(m_frame_skip);
+		}
+
+		TRACE_EXIT();
+	}
+
 	std::string
 	runtime::version(
 		__in_opt bool verbose
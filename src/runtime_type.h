@@ -60,7 +60,8 @@ namespace nescc {
 
 	#define RUNTIME_PAUSE_DELAY 200
 
-	#define RUNTIME_SDL_FLAGS (SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER | SDL_INIT_TIMER | SDL_INIT_VIDEO)
+	#define RUNTIME_SDL_FLAGS (SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER | SDL_INIT_TIMER)
+	#define RUNTIME_SDL_FLAGS_VIDEO (SDL_INIT_VIDEO)
 }
 
 #endif // NESCC_RUNTIME_TYPE_H_
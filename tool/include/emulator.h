@@ -55,6 +55,8 @@ namespace nescc {
 					__in const emulator &other
 					) = delete;
 
+				void benchmark(void);
+
 				std::string command_apu(
 					__in_opt const std::vector<std::string> &arguments = std::vector<std::string>()
 					);
@@ -119,6 +121,12 @@ namespace nescc {
 
 				void on_uninitialize(void);
 
+				uint32_t parse_count(
+					__in const std::vector<std::string> &arguments,
+					__inout std::vector<std::string>::const_iterator &iter,
+					__inout int &index
+					);
+
 				uint32_t parse_subcommand(
 					__in const std::vector<std::string> &arguments,
 					__in uint32_t command
@@ -164,16 +172,26 @@ namespace nescc {
 					__in_opt bool verbose = false
 					) const;
 
+				uint32_t m_benchmark;
+
 				bool m_crt_filter;
 
 				bool m_debug;
 
+				uint32_t m_frame_skip;
+
+				bool m_headless;
+
 				bool m_interactive;
 
+				bool m_low_power;
+
 				std::string m_path;
 
 				nescc::runtime &m_runtime;
 
+				uint32_t m_scale;
+
 				bool m_step;
 
 				uint32_t m_step_count;
@@ -0,0 +1,97 @@
+/**
+ * Nescc
+ * Copyright (C) 2017-2018 David Jolly
+ *
+ * Nescc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Nescc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../include/display.h"
+
+#ifndef CHECK_CRT_FRAMES
+	#define CHECK_CRT_FRAMES 8
+#endif // CHECK_CRT_FRAMES
+
+#ifndef CHECK_CRT_HASH
+	// hashed from the original per-pixel floating-point crt filter, given the same frames and random offsets
+	#define CHECK_CRT_HASH 0x207a73e400e51e85ULL
+#endif // CHECK_CRT_HASH
+
+#define CHECK_PATTERN_INCREMENT 12345
+#define CHECK_PATTERN_MULTIPLIER 1103515245
+#define CHECK_PATTERN_SEED 1
+
+uint64_t
+check_crt(void)
+{
+	uint64_t result;
+	uint16_t pixel_x, pixel_y;
+	uint32_t frame, pattern = CHECK_PATTERN_SEED;
+	nescc::display &instance = nescc::display::acquire();
+
+	// every pixel of every frame, alpha included, is drawn from a fixed sequence, and the scanline offsets from a fixed
+	// seed, so the filtered frame only changes if the filter's output does
+	instance.set_headless(true);
+	instance.initialize();
+	instance.set_filter_crt(true, true, true, true);
+	std::srand(CHECK_PATTERN_SEED);
+
+	for(frame = 0; frame < CHECK_CRT_FRAMES; ++frame) {
+
+		for(pixel_y = 0; pixel_y < DISPLAY_HEIGHT; ++pixel_y) {
+
+			for(pixel_x = 0; pixel_x < DISPLAY_WIDTH; ++pixel_x) {
+				pattern = ((pattern * CHECK_PATTERN_MULTIPLIER) + CHECK_PATTERN_INCREMENT);
+				instance.write(pixel_x, pixel_y, pattern);
+			}
+		}
+
+		instance.update(false, true);
+	}
+
+	result = instance.backend_headless().hash();
+	instance.uninitialize();
+	instance.release();
+
+	return result;
+}
+
+int
+main(
+	__in int argc,
+	__in const char *argv[]
+	)
+{
+	uint64_t hash;
+	int result = EXIT_SUCCESS;
+
+	try {
+		hash = check_crt();
+		std::cout << "CRT filter: " << SCALAR_AS_HEX(uint64_t, hash);
+
+		if(hash != CHECK_CRT_HASH) {
+			std::cout << " (expected " << SCALAR_AS_HEX(uint64_t, CHECK_CRT_HASH) << ")";
+			result = EXIT_FAILURE;
+		}
+
+		std::cout << (result ? " FAILED" : " PASSED") << std::endl;
+	} catch(nescc::exception &exc) {
+		std::cerr << "Error: " << exc.to_string(true) << std::endl;
+		result = EXIT_FAILURE;
+	} catch(std::exception &exc) {
+		std::cerr << "Error: " << exc.what() << std::endl;
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
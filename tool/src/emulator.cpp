@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
 #include <climits>
 #include "../include/emulator.h"
 #include "./emulator_type.h"
@@ -25,10 +26,15 @@ namespace nescc {
 	namespace tool {
 
 		emulator::emulator(void) :
+			m_benchmark(0),
 			m_crt_filter(false),
 			m_debug(false),
+			m_frame_skip(0),
+			m_headless(false),
 			m_interactive(false),
+			m_low_power(false),
 			m_runtime(nescc::runtime::acquire()),
+			m_scale(POST_PROCESS_SCALE_DEFAULT),
 			m_step(false),
 			m_step_count(0),
 			m_step_frame(false)
@@ -41,6 +47,32 @@ namespace nescc {
 			m_runtime.release();
 		}
 
+		void
+		emulator::benchmark(void)
+		{
+			uint32_t frame;
+			std::chrono::nanoseconds elapsed;
+			std::chrono::steady_clock::time_point begin;
+
+			// frames are stepped one at a time through the headless display, so neither the renderer nor the frame
+			// pacing is timed, only the emulation and the filters applied to its frames
+			m_runtime.initialize();
+			m_runtime.run(m_path, m_debug, false, true, m_crt_filter, true, m_low_power, m_frame_skip, m_scale);
+			begin = std::chrono::steady_clock::now();
+
+			for(frame = 0; frame < m_benchmark; ++frame) {
+				m_runtime.step();
+				m_runtime.wait_step();
+			}
+
+			elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+			m_runtime.terminate();
+			m_runtime.uninitialize();
+
+			std::cout << "Frames: " << m_benchmark << ", Time: " << (elapsed.count() / m_benchmark) << " ns/frame ("
+				<< FLOAT_PRECISION(1, (m_benchmark * 1e9) / elapsed.count()) << " FPS)" << std::endl;
+		}
+
 		std::string
 		emulator::command_apu(
 			__in_opt const std::vector<std::string> &arguments
@@ -870,7 +902,8 @@ namespace nescc {
 				}
 
 				m_runtime.initialize();
-				m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter);
+				m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter, m_headless, m_low_power,
+					m_frame_skip, m_scale);
 			} else {
 				result << "Unexpected command argument: " << arguments.front();
 			}
@@ -896,7 +929,8 @@ namespace nescc {
 					}
 				} else {
 					m_runtime.initialize();
-					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter);
+					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter, m_headless, m_low_power,
+						m_frame_skip, m_scale);
 				}
 			} else {
 				result << "Unexpected command argument: " << arguments.front();
@@ -968,7 +1002,8 @@ namespace nescc {
 					m_step_frame = step_frame;
 					m_step_count = 1;
 					m_runtime.initialize();
-					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter);
+					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter, m_headless, m_low_power,
+						m_frame_skip, m_scale);
 				}
 			} else if(parse_subcommand_value(arguments, value, m_step)) {
 
@@ -977,7 +1012,8 @@ namespace nescc {
 					m_step_frame = step_frame;
 					m_step_count = 1;
 					m_runtime.initialize();
-					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter);
+					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter, m_headless, m_low_power,
+						m_frame_skip, m_scale);
 				}
 
 				if(m_runtime.stepping()) {
@@ -1075,6 +1111,9 @@ namespace nescc {
 					}
 
 					switch(entry->second) {
+						case ARGUMENT_BENCHMARK:
+							m_benchmark = parse_count(arguments, iter, index);
+							break;
 						case ARGUMENT_CRT:
 							m_crt_filter = true;
 							break;
@@ -1083,12 +1122,29 @@ namespace nescc {
 							m_debug = true;
 							break;
 #endif // NDEBUG
+						case ARGUMENT_FRAME_SKIP:
+							m_frame_skip = parse_count(arguments, iter, index);
+							break;
+						case ARGUMENT_HEADLESS:
+							m_headless = true;
+							break;
 						case ARGUMENT_HELP:
 							help = true;
 							break;
 						case ARGUMENT_INTERACTIVE:
 							m_interactive = true;
 							break;
+						case ARGUMENT_LOW_POWER:
+							m_low_power = true;
+							break;
+						case ARGUMENT_SCALE:
+							m_scale = parse_count(arguments, iter, index);
+							if(m_scale > POST_PROCESS_SCALE_MAX) {
+								THROW_NESCC_TOOL_EMULATOR_EXCEPTION_FORMAT(
+									NESCC_TOOL_EMULATOR_EXCEPTION_ARGUMENT_MALFORMED,
+									"Argument[%u]=%s", index, (*iter).c_str());
+							}
+							break;
 						case ARGUMENT_VERSION:
 							version = true;
 							break;
@@ -1268,15 +1324,49 @@ namespace nescc {
 				m_runtime.uninitialize();
 			}
 
+			m_benchmark = 0;
 			m_crt_filter = false;
 			m_debug = false;
+			m_frame_skip = 0;
+			m_headless = false;
 			m_interactive = false;
+			m_low_power = false;
 			m_path.clear();
+			m_scale = POST_PROCESS_SCALE_DEFAULT;
 			m_step = false;
 			m_step_count = 0;
 			m_step_frame = false;
 		}
 
+		uint32_t
+		emulator::parse_count(
+			__in const std::vector<std::string> &arguments,
+			__inout std::vector<std::string>::const_iterator &iter,
+			__inout int &index
+			)
+		{
+			int64_t result = 0;
+			std::stringstream stream;
+
+			if((iter + 1) == arguments.end()) {
+				THROW_NESCC_TOOL_EMULATOR_EXCEPTION_FORMAT(NESCC_TOOL_EMULATOR_EXCEPTION_ARGUMENT_MISSING,
+					"Argument[%u]=%s", index, (*iter).c_str());
+			}
+
+			++index;
+			++iter;
+			stream << *iter;
+			stream >> result;
+
+			// the value is read signed, so a negative count is rejected rather than wrapped
+			if(stream.fail() || !stream.eof() || (result <= 0) || (result > UINT32_MAX)) {
+				THROW_NESCC_TOOL_EMULATOR_EXCEPTION_FORMAT(NESCC_TOOL_EMULATOR_EXCEPTION_ARGUMENT_MALFORMED,
+					"Argument[%u]=%s", index, (*iter).c_str());
+			}
+
+			return result;
+		}
+
 		uint32_t
 		emulator::parse_subcommand(
 			__in const std::vector<std::string> &arguments,
@@ -1456,9 +1546,12 @@ namespace nescc {
 				if(m_interactive) {
 					nescc::core::thread::start(true);
 					nescc::core::thread::wait();
+				} else if(m_benchmark) {
+					benchmark();
 				} else {
 					m_runtime.initialize();
-					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter);
+					m_runtime.run(m_path, m_debug, m_step, m_step_frame, m_crt_filter, m_headless, m_low_power,
+						m_frame_skip, m_scale);
 					m_runtime.wait();
 					m_runtime.uninitialize();
 				}
@@ -1633,7 +1726,10 @@ namespace nescc {
 						<< ", Mode=" << (m_interactive ? "Interactive" : "Normal")
 							<< "/" << (m_debug ? "Debug" : "Non-debug")
 							<< "/" << (m_step ? "Step" : (m_step_frame ? "Step-frame" : "Freerunning"))
-							<< "/" << (m_crt_filter ? "CRT-filter" : "Unfilitered");
+							<< "/" << (m_crt_filter ? "CRT-filter" : "Unfilitered")
+							<< "/" << (m_headless ? "Headless" : "Windowed")
+							<< "/" << (m_low_power ? "Low-power" : "Full-power")
+						<< ", Frame-skip=" << m_frame_skip;
 				}
 			}
 
@@ -73,12 +73,17 @@ namespace nescc {
 		#define ARGUMENT_DELIMITER '-'
 
 		enum {
-			ARGUMENT_CRT = 0,
+			ARGUMENT_BENCHMARK = 0,
+			ARGUMENT_CRT,
 #ifndef NDEBUG
 			ARGUMENT_DEBUG,
 #endif // NDEBUG
+			ARGUMENT_FRAME_SKIP,
+			ARGUMENT_HEADLESS,
 			ARGUMENT_HELP,
 			ARGUMENT_INTERACTIVE,
+			ARGUMENT_LOW_POWER,
+			ARGUMENT_SCALE,
 			ARGUMENT_VERSION,
 		};
 
@@ -86,11 +91,11 @@ namespace nescc {
 		#define ARGUMENT_MIN 2
 
 		static const std::string ARGUMENT_STR[] = {
-			"c",
+			"b", "c",
 #ifndef NDEBUG
 			"d",
 #endif // NDEBUG
-			"h", "i", "v",
+			"f", "n", "h", "i", "l", "s", "v",
 			};
 
 		#define ARGUMENT_STRING(_TYPE_) \
@@ -98,11 +103,11 @@ namespace nescc {
 				STRING_CHECK(ARGUMENT_STR[_TYPE_]))
 
 		static const std::string ARGUMENT_STR_LONG[] = {
-			"crt",
+			"benchmark", "crt",
 #ifndef NDEBUG
 			"debug",
 #endif // NDEBUG
-			"help", "interactive", "version",
+			"frame-skip", "headless", "help", "interactive", "low-power", "scale", "version",
 			};
 
 		#define ARGUMENT_STRING_LONG(_TYPE_) \
@@ -110,12 +115,17 @@ namespace nescc {
 				STRING_CHECK(ARGUMENT_STR_LONG[_TYPE_]))
 
 		static const std::string ARGUMENT_STR_DESC[] = {
+			"Run N frames headless and report the time per frame (-b N)",
 			"Enable CRT filter",
 #ifndef NDEBUG
 			"Run in debug mode",
 #endif // NDEBUG
+			"Render one of every N frames (-f N)",
+			"Run without a display window",
 			"Display help information",
 			"Run in interactive mode",
+			"Never redraw an unchanged display, even while paused",
+			"Scale the display N times, from 2 to 4 (-s N)",
 			"Display version information",
 			};
 
@@ -124,16 +134,26 @@ namespace nescc {
 				STRING_CHECK(ARGUMENT_STR_DESC[_TYPE_]))
 
 		static const std::map<std::string, uint32_t> ARGUMENT_MAP = {
+			std::make_pair(ARGUMENT_STRING(ARGUMENT_BENCHMARK), ARGUMENT_BENCHMARK),
+			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_BENCHMARK), ARGUMENT_BENCHMARK),
 			std::make_pair(ARGUMENT_STRING(ARGUMENT_CRT), ARGUMENT_CRT),
 			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_CRT), ARGUMENT_CRT),
 #ifndef NDEBUG
 			std::make_pair(ARGUMENT_STRING(ARGUMENT_DEBUG), ARGUMENT_DEBUG),
 			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_DEBUG), ARGUMENT_DEBUG),
 #endif // NDEBUG
+			std::make_pair(ARGUMENT_STRING(ARGUMENT_FRAME_SKIP), ARGUMENT_FRAME_SKIP),
+			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_FRAME_SKIP), ARGUMENT_FRAME_SKIP),
+			std::make_pair(ARGUMENT_STRING(ARGUMENT_HEADLESS), ARGUMENT_HEADLESS),
+			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_HEADLESS), ARGUMENT_HEADLESS),
 			std::make_pair(ARGUMENT_STRING(ARGUMENT_HELP), ARGUMENT_HELP),
 			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_HELP), ARGUMENT_HELP),
 			std::make_pair(ARGUMENT_STRING(ARGUMENT_INTERACTIVE), ARGUMENT_INTERACTIVE),
 			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_INTERACTIVE), ARGUMENT_INTERACTIVE),
+			std::make_pair(ARGUMENT_STRING(ARGUMENT_LOW_POWER), ARGUMENT_LOW_POWER),
+			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_LOW_POWER), ARGUMENT_LOW_POWER),
+			std::make_pair(ARGUMENT_STRING(ARGUMENT_SCALE), ARGUMENT_SCALE),
+			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_SCALE), ARGUMENT_SCALE),
 			std::make_pair(ARGUMENT_STRING(ARGUMENT_VERSION), ARGUMENT_VERSION),
 			std::make_pair(ARGUMENT_STRING_LONG(ARGUMENT_VERSION), ARGUMENT_VERSION),
 			};